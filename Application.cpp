@@ -1,21 +1,36 @@
+#include <algorithm>
+#include <cstdlib>
+
 #include "Application.h"
 #include "imgui/imgui.h"
 #include "classes/Chess.h"
+#include "classes/PositionDB.h"
 
 #ifdef DEBUG
 #include "tools/Logger.h"
 #endif
 
+// set at configure time with -DCHESS_POSITION_DB=..., the POSITION_DB environment variable takes priority.
+// Build one with chess_posdb.
+#ifndef CHESS_POSITION_DB
+#define CHESS_POSITION_DB ""
+#endif
+
 namespace ClassGame {
 	Chess *game = nullptr;
 	bool gameOver = false;
 	int gameWinner = -1;
 
+	PositionDB positionDB;
+
 	// game starting point
 	// this is called by the main render loop in main.cpp
 	void GameStartUp() {
 		game = new Chess();
 		game->setUpBoard();
+
+		const char* dbPath = std::getenv("POSITION_DB");
+		positionDB.open(dbPath ? dbPath : CHESS_POSITION_DB);
 	}
 
 	void drawMoveProber() {
@@ -54,6 +69,58 @@ namespace ClassGame {
 		ImGui::EndChild();
 	}
 
+	// what was played from the current position in the database's games, most popular first.
+	void drawOpeningExplorer() {
+		ImGui::Begin("Opening Explorer");
+		if (!positionDB.isOpen()) {
+			ImGui::TextWrapped("No position database loaded. Build one with chess_posdb and point POSITION_DB at it.");
+			ImGui::End();
+			return;
+		}
+
+		const GameState state = game->getState();
+		std::vector<PositionDB::Entry> entries;
+		for (const PositionDB::Entry& entry : positionDB.find(state)) {
+			entries.push_back(entry);
+		}
+		std::sort(entries.begin(), entries.end(), [](const PositionDB::Entry& a, const PositionDB::Entry& b) {
+			return a.games() > b.games();
+		});
+
+		uint64_t total = 0;
+		for (const PositionDB::Entry& entry : entries) {
+			total += entry.games();
+		}
+		ImGui::Text("%llu games reached this position", (unsigned long long)total);
+
+		const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+		if (!entries.empty() && ImGui::BeginTable("Explorer", 5, flags)) {
+			ImGui::TableSetupColumn("Move");
+			ImGui::TableSetupColumn("Games");
+			ImGui::TableSetupColumn("White");
+			ImGui::TableSetupColumn("Draw");
+			ImGui::TableSetupColumn("Black");
+			ImGui::TableHeadersRow();
+
+			for (const PositionDB::Entry& entry : entries) {
+				const float games = (float)entry.games();
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::Text("%s", PGN::toSAN(state, entry.toMove()).c_str());
+				ImGui::TableSetColumnIndex(1);
+				ImGui::Text("%u", entry.games());
+				ImGui::TableSetColumnIndex(2);
+				ImGui::Text("%.1f%%", 100 * entry.white / games);
+				ImGui::TableSetColumnIndex(3);
+				ImGui::Text("%.1f%%", 100 * entry.draws / games);
+				ImGui::TableSetColumnIndex(4);
+				ImGui::Text("%.1f%%", 100 * entry.black / games);
+			}
+			ImGui::EndTable();
+		}
+		ImGui::End();
+	}
+
 	const std::map<ChessPiece, char> symbolFromPiece = {
 		{ChessPiece::Pawn, 'p'},
 		{ChessPiece::Knight, 'n'},
@@ -206,6 +273,8 @@ namespace ClassGame {
 		ImGui::Begin("GameWindow");
 		game->drawFrame();
 		ImGui::End();
+
+		drawOpeningExplorer();
 		#ifdef DEBUG
 		Loggy.draw();
 		#endif
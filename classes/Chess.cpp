@@ -1,10 +1,13 @@
 #include <cmath>
+#include <cstdlib>
 #include <stdexcept>
 
 #include "Chess.h"
 #include "MagicBitboards/MagicBitboards.h"
 
 #include "ChessAI.h"
+#include "KPKBitbase.h"
+#include "NNUE.h"
 
 #ifdef DEBUG
 #include "../tools/Logger.h"
@@ -14,16 +17,23 @@
 
 const int MAX_DEPTH = 5;
 
+// set at configure time with -DCHESS_NNUE_PATH=..., the NNUE_PATH environment variable takes priority.
+// Without a network the AI uses the hand crafted evaluation.
+#ifndef CHESS_NNUE_PATH
+#define CHESS_NNUE_PATH ""
+#endif
+
 Chess::Chess() {
-	initMagicBitboards();
+	KPK::init();
+
+	const char* networkPath = std::getenv("NNUE_PATH");
+	NNUE::load(networkPath ? networkPath : CHESS_NNUE_PATH);
 
 	// TODO: Let player set this by hand.
 	_gameOps.AIPlayer = 1;
 }
 
-Chess::~Chess() {
-	cleanupMagicBitboards();
-}
+Chess::~Chess() {}
 
 const int spriteSize = 64;
 // make a chess piece for the player
@@ -287,15 +297,17 @@ void Chess::updateAI() {
 	Loggy.log("Starting AI Occuancy: " + std::to_string(currState.getOccupancyBoard()));
 	#endif
 
-	// these values are inverted b/c creating the newstate will effectively the values anyways.
+	// these values are inverted b/c making the move will effectively the values anyways.
 	const int player = currState.isBlackTurn() ? 1 : -1;
+	// one search for every root move, so the per ply states only get allocated once.
+	ChessAI ai(currState);
 	for (const Move& move : _currentMoves) {
-		ChessAI newState = ChessAI(GameState(currState, move));
+		ai.makeMove(move);
 		#ifdef DEBUG
-		//uint64_t bit = newState.logDebugInfo();
+		//uint64_t bit = ai.logDebugInfo();
 		#endif
-		//newState.reserveMemoryStack(MAX_DEPTH);
-		int moveVal = -newState.negamax(MAX_DEPTH, 0, -inf, inf, player);
+		int moveVal = -ai.negamax(MAX_DEPTH, 0, -inf, inf, player);
+		ai.unmakeMove(move);
 		
 		if (moveVal > bestVal) {
 			bestMove = &move;
@@ -41,6 +41,10 @@ public:
 	// This will only be correct if called after MoveGenerator is called.
 	static bool InCheck();
 	static void sortMovesByMVVLVA(ProtoBoard&, std::vector<Move>&);
+	// Is square attacked by the side not to move, given this occupancy? Pass a modified occupancy to ask hypotheticals.
+	static bool isSquareAttacked(const GameState&, const uint8_t square, const uint64_t occupancy);
+	// Every square attacked by one side. Move generation doesn't need this, it's here for evaluation & debugging.
+	static uint64_t AttackMap(const GameState&, const bool byBlack);
 
 	void		stopGame() override;
 	BitHolder&	getHolderAt(const int x, const int y) override { return _grid[y * 8 + x]; }
@@ -60,18 +64,18 @@ private:
     const char		bitToPieceNotation(int i) const;
 	inline void 	clearPositionHighlights();
 
-	static void CalculateAttackData(GameState&);
-	static void GeneratePawnMoves(std::vector<Move>&, GameState&);
-	static inline void GeneratePawnPush(std::vector<Move>&,   GameState&, const uint64_t, const uint8_t);
-	static inline void GeneratePawnAttack(std::vector<Move>&, GameState&, const uint64_t, const uint8_t); // helper
-	static void GenerateKnightMoves(std::vector<Move>&,  GameState&);
-	static void GenerateSlidingMoves(std::vector<Move>&, GameState&);
-	static inline void GenerateSlidingMovesHelper(std::vector<Move>&, const std::function<uint64_t(uint8_t, uint64_t)>&, const uint64_t&, const uint64_t&, const uint64_t&, const uint64_t&);
-	static void GenerateKingMoves(std::vector<Move>&, GameState&);
+	// Everything colour dependent is resolved at compile time, MoveGenerator picks the instantiation once per call.
+	template<Color Us> static void GenerateMoves(std::vector<Move>&, GameState&);
+	template<Color Us> static void CalculateAttackData(GameState&);
+	template<Color Us> static void GeneratePawnMoves(std::vector<Move>&, GameState&);
+	template<Color Us> static inline void GeneratePawnTargets(std::vector<Move>&, const uint64_t, const uint64_t, const uint64_t, const uint64_t); // helper
+	template<Color Us> static void GenerateKnightMoves(std::vector<Move>&,  GameState&);
+	template<Color Us> static void GenerateSlidingMoves(std::vector<Move>&, GameState&);
+	template<ChessPiece Slider>
+	static inline void GenerateSlidingMovesHelper(std::vector<Move>&, const uint64_t, const uint64_t, const uint64_t);
+	template<Color Us> static void GenerateKingMoves(std::vector<Move>&, GameState&);
 
 	static bool isPinned(int);
-	static bool isMovingAlongRay(int, int, int);
-	static bool squareIsInCheckRay(int);
 
 	ChessSquare	_grid[64];
 	std::stack<GameState> _state;
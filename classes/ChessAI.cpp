@@ -1,6 +1,9 @@
 #include "ChessAI.h"
 #include "MagicBitboards/BitFunctions.h"
-#include "MagicBitboards/EvaluationTables.h"
+#include "KPKBitbase.h"
+#include "NNUE.h"
+#include "PieceActivity.h"
+#include "PieceSquare.h"
 
 #ifdef DEBUG
 #include "../tools/Logger.h"
@@ -8,61 +11,105 @@
 
 const int inf = 999999UL;
 
-ChessAI::ChessAI(GameState state) : _state(state), _board(state.getProtoBoard()) {
-    
+ChessAI::ChessAI(const GameState& state) : _stack(state), _pv(MAX_PLY + 1) {
+
 }
 
-// Piece Values
-static std::map<ChessPiece, int> evaluateScores = {
-    {Pawn, 100},
-    {Knight, 200},
-    {Bishop, 230},
-    {Rook, 400},
-    {Queen, 900},
-    {King, 2000}
-};
+SearchResult ChessAI::search(const int depth, const uint64_t nodeLimit) {
+	SearchResult result;
+	_nodes = 0;
+	_stopped = false;
+	const uint64_t evalHits = _evalHits, evalMisses = _evalMisses;
+
+	const int player = _stack.current().isBlackTurn() ? -1 : 1;
+	for (int iteration = 1; iteration <= depth; iteration++) {
+		_nodeLimit = iteration > 1 ? nodeLimit : 0;
+		const int score = negamax(iteration, 0, -inf, inf, player);
+		if (_stopped) break;
+
+		result.score = score;
+		result.depth = iteration;
+		result.pv = _pv[0];
+	}
+
+	result.nodes = _nodes;
+	result.evalHits = _evalHits - evalHits;
+	result.evalMisses = _evalMisses - evalMisses;
+	if (!result.pv.empty()) {
+		result.bestMove = result.pv[0];
+	}
+	return result;
+}
+
+// Known wins still need to rank below mate, but well above anything material can add up to in a pawn ending.
+const int KNOWN_WIN = 1000;
+
+// King + Pawn vs King is solved, so look it up instead of guessing. Only call with exactly 2 kings & a pawn on the board.
+static int evaluateKPK(const GameState& state, const ProtoBoard& board) {
+	const bool strongIsBlack = board[0] == 0;
+	uint8_t strongKing = bitScanForward(board[strongIsBlack ? 11 : 5]);
+	uint8_t weakKing   = bitScanForward(board[strongIsBlack ? 5 : 11]);
+	uint8_t pawn       = bitScanForward(board[strongIsBlack ? 6 : 0]);
+	const bool weakToMove = state.isBlackTurn() != strongIsBlack;
+
+	// bitbase is stored from white's side with the pawn on files a-d, so flip & mirror to match.
+	if (strongIsBlack) {
+		strongKing ^= 56;
+		weakKing   ^= 56;
+		pawn       ^= 56;
+	}
+	if ((pawn % 8) > 3) {
+		strongKing ^= 7;
+		weakKing   ^= 7;
+		pawn       ^= 7;
+	}
+
+	if (!KPK::probe(strongKing, pawn, weakKing, weakToMove)) {
+		return 0;
+	}
+
+	// still reward pushing the pawn so search actually makes progress.
+	const int score = KNOWN_WIN + (pawn / 8) * 20;
+	return strongIsBlack ? -score : score;
+}
 
 // Returns: positive value if AI wins, negative if human player wins, 0 for draw or undecided
 int ChessAI::evaluateBoard() {
-	int score = 0;
-	for (int i = 0; i < 12; i++) {
-		// To simplify my statements a bit, I'll be adding the passes
-		// after I calculate their score, so I can subtract if black and add if white.
-		ChessPiece piece = ProtoBoard::PieceFromProtoIndex(i);
-		bool black = (piece & 8) != 0;
-		piece = (ChessPiece)(piece & 7);
-
-		// Add up scores of each piece, ignoring position.
-		int passScore = evaluateScores[piece] * popCount(_board[i]);
-		forEachBit([&passScore, &piece, &black](uint8_t pos){
-			uint8_t truePos = pos;
-			if (black) {
-				truePos = pos ^ 56;
-				// flip
-			}
+	const uint64_t key = _stack.current().getKey();
+	int score;
+	if (_evalCache.probe(key, score)) {
+		_evalHits++;
+		return score;
+	}
 
-			switch(piece) {
-				case Pawn:
-					passScore += pawnTable[truePos];
-					break;
-				case Knight:
-					passScore += knightTable[truePos];
-					break;
-				case Bishop:
-					passScore += bishopTable[truePos];
-					break;
-				case Rook:
-					passScore += rookTable[truePos];
-					break;
-				case Queen:
-					passScore += queenTable[truePos];
-					break;
-			}
-		}, _board[i]);
+	_evalMisses++;
+	score = evaluateUncached();
+	_evalCache.store(key, score);
+	return score;
+}
 
-		score += black ? -passScore : passScore;
+int ChessAI::evaluateUncached() {
+	const GameState& state = _stack.current();
+	const ProtoBoard& board = state.getProtoBoard();
+
+	// with only 3 pieces on the board, the third being a pawn means this is KPK.
+	if (popCount(board.getOccupancyBoard()) == 3 && (board[0] | board[6]) != 0) {
+		return evaluateKPK(state, board);
+	}
+
+	if (NNUE::isLoaded()) {
+		// the network scores for the side to move, everything else here is from white's side.
+		const int score = NNUE::evaluate(_stack.accumulator(), state.isBlackTurn());
+		return state.isBlackTurn() ? -score : score;
 	}
 
+	// material & piece square tables. The old per-bit loop is PieceSquare::evaluateScalar, same result.
+	int score = PieceSquare::evaluate(board);
+
+	const PawnHashTable::Entry& pawns = _pawnHash.probe(state.getPawnKey(), board);
+	score += pawns.score + PawnStructure::evaluatePassers(board, pawns.passed);
+	score += PieceActivity::evaluate(board);
+
 	return score;
 }
 
@@ -89,6 +136,15 @@ int Chess::evaluateBoard(const char* state) {
 */
 
 int ChessAI::negamax(const int depth, const int distFromRoot, int alpha, int beta, const int player) {
+	GameState& state = _stack.current();
+	_pv[distFromRoot].clear();
+
+	_nodes++;
+	if (_nodeLimit && _nodes >= _nodeLimit) {
+		_stopped = true;
+		return 0;
+	}
+
     if (depth == 0) {
 		// TODO: return quiesce search instead
 		// For now just calls evaluate board and returns that immediately.
@@ -100,7 +156,7 @@ int ChessAI::negamax(const int depth, const int distFromRoot, int alpha, int bet
     }
 
 	// Todo: TranspositionTable optimisation would be nice.
-	std::vector<Move> moves = Chess::MoveGenerator(_state, false);
+	std::vector<Move> moves = Chess::MoveGenerator(state, false);
 
 	// if no moves
 	if (moves.empty()) {
@@ -135,13 +191,23 @@ int ChessAI::negamax(const int depth, const int distFromRoot, int alpha, int bet
 		#endif
 
 		// Make, Mo' Nega, Unmake, Prune.
-		GameStateMemory memory = _state.makeMemoryState();
-		_state.MakeMove(move);
+		_stack.push(move);
 		#ifdef DEBUG
 		//uint64_t bit = logDebugInfo();
 		#endif
-		bestValue = std::max(bestValue, -negamax(depth - 1, distFromRoot + 1, -beta, -alpha, -player));
-		_state.UnmakeMove(move, memory);
+		const int value = -negamax(depth - 1, distFromRoot + 1, -beta, -alpha, -player);
+		_stack.pop(move);
+		if (_stopped) return 0;
+
+		if (value > bestValue) {
+			bestValue = value;
+			if (value > alpha) {
+				std::vector<Move>& line = _pv[distFromRoot];
+				line.clear();
+				line.push_back(move);
+				line.insert(line.end(), _pv[distFromRoot + 1].begin(), _pv[distFromRoot + 1].end());
+			}
+		}
 
 		alpha = std::max(bestValue, alpha);
 
@@ -184,7 +250,7 @@ int ChessAI::Quiesce(int alpha, int beta) {
 
 // Eventually add more neuanced draw detection like three fold repetition
 bool ChessAI::isDraw() const {
-	if (_state.getHalfClock() >= 50) {
+	if (_stack.current().getHalfClock() >= 50) {
 		return true;
 	}
 	
@@ -193,8 +259,9 @@ bool ChessAI::isDraw() const {
 
 #ifdef DEBUG
 uint64_t ChessAI::logDebugInfo() const {
-	uint64_t bits = _board.getOccupancyBoard();
-	Loggy.log("Occupancy - " + std::to_string(bits) + " - isBlack: " + std::to_string(_state.isBlackTurn()));
+	const GameState& state = _stack.current();
+	uint64_t bits = state.getOccupancyBoard();
+	Loggy.log("Occupancy - " + std::to_string(bits) + " - isBlack: " + std::to_string(state.isBlackTurn()));
 	return bits;
 }
 #endif
\ No newline at end of file
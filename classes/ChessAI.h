@@ -1,12 +1,39 @@
 #pragma once
 
+#include <vector>
+
 #include "Chess.h"
+#include "EvalCache.h"
+#include "PawnStructure.h"
+#include "PlyStack.h"
+
+struct SearchResult {
+    Move bestMove = Move(0, 0);
+    int score = 0;        // from the side to move's point of view
+    int depth = 0;        // deepest iteration that finished
+    uint64_t nodes = 0;
+    uint64_t evalHits = 0;   // evaluations answered by the eval cache
+    uint64_t evalMisses = 0; // evaluations actually computed
+    std::vector<Move> pv;
+};
 
 class ChessAI {
     public:
-    ChessAI(GameState);
+    ChessAI(const GameState&);
+
+    // swaps in a new root position, so one ChessAI can be reused for lots of searches.
+    void setPosition(const GameState& state) { _stack.reset(state); }
+
+    // Iterative deepening from the current position up to depth. With a nodeLimit, stops once that many nodes
+    // have been searched and returns the last iteration that finished (depth 1 always finishes).
+    SearchResult search(const int depth, const uint64_t nodeLimit = 0);
+
+    // plays/takes back a move on top of the search's current position, ex. for trying each root move in turn.
+    void makeMove(const Move& move) { _stack.push(move); }
+    void unmakeMove(const Move& move) { _stack.pop(move); }
 
     // Returns: positive value if AI wins, negative if human player wins, 0 for draw or undecided
+    // Goes through the eval cache, so positions seen before aren't evaluated again.
     int evaluateBoard();
 
     // init like this : negamax(rootState, depth, -inf, +inf, 1)
@@ -16,6 +43,12 @@ class ChessAI {
 
     int Quiesce(const int alpha, const int beta);
 
+    // pawn structure cache, exposed for the hit rate.
+    const PawnHashTable& pawnHash() const { return _pawnHash; }
+    // eval cache counters since this ChessAI was made, search() reports its own in SearchResult.
+    uint64_t evalHits() const { return _evalHits; }
+    uint64_t evalMisses() const { return _evalMisses; }
+
     #ifdef DEBUG
     // This is purely for debugging.
     uint64_t logDebugInfo() const;
@@ -23,7 +56,16 @@ class ChessAI {
 
     private:
     bool isDraw() const;
+    int evaluateUncached();
 
-    GameState& _state;
-    ProtoBoard& _board;
+    PlyStack _stack;
+    PawnHashTable _pawnHash;
+    EvalCache _evalCache;
+    uint64_t _evalHits = 0;
+    uint64_t _evalMisses = 0;
+    // triangular PV table, _pv[ply] is the best line found from that ply.
+    std::vector<std::vector<Move>> _pv;
+    uint64_t _nodes = 0;
+    uint64_t _nodeLimit = 0;
+    bool _stopped = false;
 };
\ No newline at end of file
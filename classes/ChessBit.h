@@ -1,5 +1,5 @@
 #pragma once
-#include "bit.h"
+#include "Bit.h"
 
 class ChessBit : public Bit {
     public:
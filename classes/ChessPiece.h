@@ -11,6 +11,17 @@ enum ChessPiece : uint8_t {
 	Black   = 1ULL << 3
 };
 
+// Side to move. Scoped so it doesn't clash with ChessPiece::Black, which is the colour bit on a piece.
+// Mostly here so the move generator can be instantiated per colour.
+enum class Color : uint8_t {
+	White = 0,
+	Black = 1
+};
+
+constexpr Color operator~(const Color color) {
+	return color == Color::White ? Color::Black : Color::White;
+}
+
 enum PositionMasks : uint64_t {
 	WhiteKingsideMask  = 1ULL << 5  | 1ULL << 6,  // F1, G1
 	BlackKingsideMask  = 1ULL << 61 | 1ULL << 62, // F8, G8
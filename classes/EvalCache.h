@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Static evaluations by position key, so positions reached through different move orders only get evaluated once.
+// https://www.chessprogramming.org/Evaluation_Hash_Table
+// Direct mapped, always replace. Each entry is one 64 bit word: the top 48 bits of the key with the score in the bottom
+// 16, so a read always sees a key & score that were written together. That makes it safe to share between threads
+// without any locking, relaxed loads & stores are plain movs.
+class EvalCache {
+	public:
+	// size in entries, rounded down to a power of two. 64K entries is 512KB.
+	explicit EvalCache(const size_t entries = 1 << 16) {
+		size_t size = 1;
+		while (size * 2 <= entries) size *= 2;
+		_entries = std::vector<std::atomic<uint64_t>>(size);
+		_mask = size - 1;
+	}
+
+	// true & fills score if this key's been stored.
+	bool probe(const uint64_t key, int& score) const {
+		const uint64_t entry = _entries[key & _mask].load(std::memory_order_relaxed);
+		if ((entry ^ key) & KEY_MASK) return false;
+		score = (int16_t)(entry & 0xffff);
+		return true;
+	}
+
+	// scores that don't fit in 16 bits just don't get cached.
+	void store(const uint64_t key, const int score) {
+		if (score < INT16_MIN || score > INT16_MAX) return;
+		_entries[key & _mask].store((key & KEY_MASK) | (uint16_t)score, std::memory_order_relaxed);
+	}
+
+	private:
+	static const uint64_t KEY_MASK = ~0xffffULL;
+
+	std::vector<std::atomic<uint64_t>> _entries;
+	uint64_t _mask;
+};
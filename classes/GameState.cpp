@@ -1,5 +1,11 @@
+#include <array>
+#include <cctype>
 #include <cstring>
+#include <limits>
+#include <stdexcept>
 #include "GameState.h"
+#include "MagicBitboards/BitFunctions.h"
+#include "Zobrist.h"
 
 #ifdef DEBUG
 #include "../tools/Logger.h"
@@ -16,118 +22,248 @@ GameState::GameState(const ProtoBoard& board, const bool isBlack, const uint8_t
 	enPassantSquare(enTarget),
 	halfClock(hClock),
 	clock(fClock),
+	key(Zobrist::computeKey(board, isBlack, castling, enTarget)),
+	pawnKey(Zobrist::computePawnKey(board)),
 	friendlyKingSquare(isBlack ? bKingSquare : wKingSquare),
 	enemyKingSquare(isBlack ? wKingSquare : bKingSquare),
 	capturedPieceType(NoPiece) {}
 
 // generate next move
-GameState::GameState(const GameState& old, const Move& move)
-	: bits(old.bits),
-	isBlack(!old.isBlack),
-	// scuffed bit funkery: take old rights, mask out side's bits if castling happened.
-	castlingRights(old.castlingRights & ~((move.KingSideCastle()  ? (isBlack ? 0b1000 : 0b0010) : 0) 
-	                                    | (move.QueenSideCastle() ? (isBlack ? 0b0100 : 0b0001) : 0))),
-	// if double push, then get the square jumped over in turn and mark as EnPassant square.
-	enPassantSquare(move.isDoublePush() ? (move.getTo() + (isBlack ? -8 : 8)) : 255), // 255 b/c not a value normally reachable in gameplay
-	halfClock(old.halfClock + 1),
-	clock(old.isBlack ? old.clock + 1 : old.clock),
-	friendlyKingSquare(old.enemyKingSquare),
-	enemyKingSquare(old.friendlyKingSquare),
-	capturedPieceType(NoPiece)
-	{
-
-	uint8_t from = move.getFrom();
-	uint8_t to   = move.getTo();
-
-	ChessPiece piece  = bits.PieceFromIndex(from);
-	ChessPiece target = bits.PieceFromIndex(to);
-	bool capture = (target != NoPiece);
-
-	bits.enable(piece, to);
-	bits.disable(piece, from);
+// copy-make is just make on a copy, keeping one implementation means the two can't drift apart.
+GameState::GameState(const GameState& old, const Move& move) : GameState(old) {
+	MakeMove(move);
+}
 
-	// updating enemy king square may seem weird, but keep in mind that a state represents the board as the player
-	// is making their move.
-	if ((piece & 7) == ChessPiece::King) {
-		enemyKingSquare = to;
-		castlingRights &= !isBlack ? ~0b0011 : ~0b1100;
+const uint8_t INVALID_POS = 255;
+
+// FEN symbols indexed by ChessPiece, so writing a piece is a single lookup.
+static const char FEN_SYMBOLS[16] = { '?', 'P', 'N', 'B', 'R', 'Q', 'K', '?', '?', 'p', 'n', 'b', 'r', 'q', 'k', '?' };
+
+static ChessPiece pieceFromFENSymbol(const char symbol) {
+	switch (symbol) {
+		case 'P': return Pawn;
+		case 'N': return Knight;
+		case 'B': return Bishop;
+		case 'R': return Rook;
+		case 'Q': return Queen;
+		case 'K': return King;
+		case 'p': return (ChessPiece)(Pawn | Black);
+		case 'n': return (ChessPiece)(Knight | Black);
+		case 'b': return (ChessPiece)(Bishop | Black);
+		case 'r': return (ChessPiece)(Rook | Black);
+		case 'q': return (ChessPiece)(Queen | Black);
+		case 'k': return (ChessPiece)(King | Black);
+		default:  throw std::runtime_error(std::string("Invalid FEN string. Unknown piece: ") + symbol);
+	}
+}
 
-		if (move.isCastle()) {
-			const uint8_t offset = !isBlack ? 56 : 0;
-			const uint8_t originalRookSquare = (move.QueenSideCastle() ? 0 : 7) + offset;
-			const uint8_t movedRookSquare    = (move.QueenSideCastle() ? 3 : 5) + offset;
+static void skipSpaces(const std::string_view fen, size_t& i) {
+	while (i < fen.size() && fen[i] == ' ') i++;
+}
 
-			const ChessPiece lookup = (ChessPiece)(ChessPiece::Rook | (!isBlack << 3));
+// reads an optional clock field. Anything that isn't a number is left alone, so EPD operations after the
+// position (ex. "bm Nf3;") don't trip the parser.
+template <typename T>
+static T readClock(const std::string_view fen, size_t& i, const T fallback) {
+	skipSpaces(fen, i);
+	if (i >= fen.size() || !std::isdigit((unsigned char)fen[i])) return fallback;
+
+	uint32_t value = 0;
+	for (; i < fen.size() && std::isdigit((unsigned char)fen[i]); i++) {
+		value = value * 10 + (fen[i] - '0');
+		if (value > std::numeric_limits<T>::max()) {
+			throw std::runtime_error("Invalid FEN string. Clock is out of range: " + std::string(fen));
+		}
+	}
+	return (T)value;
+}
 
-			bits.enable(lookup, movedRookSquare);
-			bits.disable(lookup, originalRookSquare);
+// modified from Sebastian Lague's Coding Adventure on Chess. 2:37
+// Everything after the board is optional, since a lot of the test positions I've been using are board only.
+GameState GameState::FromFEN(const std::string_view fen) {
+	ProtoBoard board;
+	uint8_t wKingSquare = INVALID_POS;
+	uint8_t bKingSquare = INVALID_POS;
+
+	size_t i = 0;
+	skipSpaces(fen, i);
+	{ int rank = 7, file = 0;
+	for (; i < fen.size() && fen[i] != ' '; i++) {
+		const char symbol = fen[i];
+		if (symbol == '/') {
+			if (file != 8 || rank == 0) {
+				throw std::runtime_error("Invalid FEN string. Rank doesn't add up to 8 squares: " + std::string(fen));
+			}
+			rank--;
+			file = 0;
+		} else if (symbol >= '1' && symbol <= '8') {
+			// this is for the gap syntax.
+			file += symbol - '0';
+		} else { // there is a piece here
+			const ChessPiece piece = pieceFromFENSymbol(symbol);
+			if (file >= 8) {
+				throw std::runtime_error("Invalid FEN string. Rank doesn't add up to 8 squares: " + std::string(fen));
+			}
+
+			const uint8_t square = rank * 8 + file;
+			if ((piece & 7) == King) {
+				uint8_t& kingSquare = (piece & Black) ? bKingSquare : wKingSquare;
+				if (kingSquare != INVALID_POS) {
+					throw std::runtime_error("Invalid FEN string. More than one king per side: " + std::string(fen));
+				}
+				kingSquare = square;
+			} else if ((piece & 7) == Pawn && (rank == 0 || rank == 7)) {
+				throw std::runtime_error("Invalid FEN string. Pawn on the back rank: " + std::string(fen));
+			}
+
+			board.enable(piece, square);
+			file++;
+		}
+
+		if (file > 8) {
+			throw std::runtime_error("Invalid FEN string. Rank doesn't add up to 8 squares: " + std::string(fen));
 		}
-	} else if ((piece & 7) == ChessPiece::Pawn) {
-		halfClock = 0;
 	}
+	if (rank != 0 || file != 8) {
+		throw std::runtime_error("Invalid FEN string. Board needs 8 full ranks: " + std::string(fen));
+	}}
 
-	if (to == old.enPassantSquare) {
-		halfClock = 0;
-		uint8_t offset = piece & 8 ? (to + 8) : to - 8;
-		bits.disable((ChessPiece)(piece ^ (1U << 3)), offset);
-		capturedPieceType = Pawn;
-	} else if (capture) {
-		halfClock = 0;
-		capturedPieceType = target;
-		bits.disable(target, to);
+	if (wKingSquare == INVALID_POS || bKingSquare == INVALID_POS) {
+		throw std::runtime_error("Invalid FEN string. King is missing!");
+	}
 
-		// update castling rights if a rook was taken
-		if (to == 56 || to == 0) {
-			castlingRights &= isBlackTurn() ? ~0b0001 : ~0b0100;
-		} else if (to == 63 || to == 7) {
-			castlingRights &= isBlackTurn() ? ~0b0010 : ~0b1000;
+	// extract the game state part of FEN
+	skipSpaces(fen, i);
+	bool isBlack = false;
+	if (i < fen.size()) {
+		if (fen[i] != 'w' && fen[i] != 'b') {
+			throw std::runtime_error("Invalid FEN string. Side to move must be w or b: " + std::string(fen));
 		}
-	
-	// TODO: at some point i was a dumbass and never put checks here to make sure king couldn't trigger castling
-	// by simply moving his ass to the destination square, which summons a rook for him???
-	// regardless... make sure to properly put checks here. Also consider changing when move.isCastle() can be true
-	// perhaps it would make sense to no longer mark every single king move as a castle (duh)
-	} else if (move.isPromotion()) {
-		ChessPiece newPiece;
-		switch(move.getFlags() & Move::FlagCodes::Promotion) {
-			case Move::FlagCodes::ToQueen:
-				newPiece = ChessPiece::Queen;
-				break;
-			case Move::FlagCodes::ToKnight:
-				newPiece = ChessPiece::Knight;
-				break;
-			case Move::FlagCodes::ToRook:
-				newPiece = ChessPiece::Rook;
-				break;
-			case Move::FlagCodes::ToBishop:
-				newPiece = ChessPiece::Bishop;
-				break;
+		isBlack = fen[i++] == 'b';
+	}
+
+	skipSpaces(fen, i);
+	uint8_t castling = 15;
+	if (i < fen.size()) {
+		castling = 0;
+		if (fen[i] == '-') {
+			i++;
+		} else {
+			for (; i < fen.size() && fen[i] != ' '; i++) {
+				switch (fen[i]) {
+					case 'K': castling |= 1 << 3; break;
+					case 'Q': castling |= 1 << 2; break;
+					case 'k': castling |= 1 << 1; break;
+					case 'q': castling |= 1; break;
+					default: throw std::runtime_error("Invalid FEN string. Unknown castling right: " + std::string(fen));
+				}
+			}
+		}
+	}
+
+	// if Kings or rooks are not in starting position, then disable that side's ability to castle.
+	if (wKingSquare != WhiteKingStartMask) castling &= 0b0011;
+	if (bKingSquare != BlackKingStartMask) castling &= 0b1100;
+	const uint64_t whiteRooks = board[3];
+	const uint64_t blackRooks = board[9];
+	if (!(whiteRooks & (1ULL << 7)))  castling &= ~0b1000;
+	if (!(whiteRooks & (1ULL << 0)))  castling &= ~0b0100;
+	if (!(blackRooks & (1ULL << 63))) castling &= ~0b0010;
+	if (!(blackRooks & (1ULL << 56))) castling &= ~0b0001;
+
+	skipSpaces(fen, i);
+	uint8_t enTarget = INVALID_POS;
+	if (i < fen.size()) {
+		if (fen[i] == '-') {
+			i++;
+		} else {
+			// the target is behind the pawn that just double pushed, so it's on the 6th rank when white is to move.
+			const char expectedRank = isBlack ? '3' : '6';
+			if (i + 1 >= fen.size() || fen[i] < 'a' || fen[i] > 'h' || fen[i + 1] != expectedRank) {
+				throw std::runtime_error("Invalid FEN string. Bad en passant square: " + std::string(fen));
+			}
+			const int col = fen[i] - 'a';
+			const int row = fen[i + 1] - '1';
+			enTarget = (row << 3) | col;
+			i += 2;
 		}
-		bits.disable((ChessPiece)(Pawn | (!isBlack << 3)), to);
-		bits.enable((ChessPiece)(newPiece | (!isBlack << 3)), to);
 	}
+
+	const uint8_t  hClock = readClock<uint8_t>(fen, i, 0);
+	const uint16_t fClock = readClock<uint16_t>(fen, i, 1);
+
+	return GameState(board, isBlack, castling, enTarget, hClock, fClock, wKingSquare, bKingSquare);
 }
 
-GameState::GameState(const GameState& other) {
-	castlingRights = other.castlingRights;
-	enPassantSquare = other.enPassantSquare;
-	halfClock = other.halfClock;
-	clock = other.clock;
-	isBlack = other.isBlack;
-	bits = other.bits;
+static char* writeNumber(char* out, unsigned value) {
+	char digits[8];
+	int count = 0;
+	do {
+		digits[count++] = '0' + value % 10;
+		value /= 10;
+	} while (value);
+
+	while (count) {
+		*out++ = digits[--count];
+	}
+	return out;
 }
 
-GameState& GameState::operator=(const GameState& other) {
-	if (this != &other) {
-		castlingRights = other.castlingRights;
-		enPassantSquare = other.enPassantSquare;
-		halfClock = other.halfClock;
-		clock = other.clock;
-		isBlack = other.isBlack;
-		bits = other.bits;
-		//std::memcpy(state, other.state, sizeof(state));
+size_t GameState::ToFEN(const GameState& state, char* buffer) {
+	const ProtoBoard& board = state.bits;
+
+	ChessPiece mailbox[64] = {};
+	for (int i = 0; i < 12; i++) {
+		const ChessPiece piece = ProtoBoard::PieceFromProtoIndex(i);
+		forEachBit([&mailbox, piece](uint8_t square) {
+			mailbox[square] = piece;
+		}, board[i]);
+	}
+
+	char* out = buffer;
+	for (int rank = 7; rank >= 0; rank--) {
+		int empty = 0;
+		for (int file = 0; file < 8; file++) {
+			const ChessPiece piece = mailbox[rank * 8 + file];
+			if (piece == NoPiece) {
+				empty++;
+				continue;
+			}
+			if (empty) {
+				*out++ = '0' + empty;
+				empty = 0;
+			}
+			*out++ = FEN_SYMBOLS[piece];
+		}
+		if (empty) *out++ = '0' + empty;
+		if (rank) *out++ = '/';
+	}
+
+	*out++ = ' ';
+	*out++ = state.isBlack ? 'b' : 'w';
+	*out++ = ' ';
+
+	const uint8_t rights = state.castlingRights;
+	if (rights == 0) *out++ = '-';
+	if (rights & 0b1000) *out++ = 'K';
+	if (rights & 0b0100) *out++ = 'Q';
+	if (rights & 0b0010) *out++ = 'k';
+	if (rights & 0b0001) *out++ = 'q';
+	*out++ = ' ';
+
+	if (state.enPassantSquare < 64) {
+		*out++ = 'a' + (state.enPassantSquare & 7);
+		*out++ = '1' + (state.enPassantSquare >> 3);
+	} else {
+		*out++ = '-';
 	}
-	return *this;
+	*out++ = ' ';
+
+	out = writeNumber(out, state.halfClock);
+	*out++ = ' ';
+	out = writeNumber(out, state.clock);
+	*out = '\0';
+	return out - buffer;
 }
 
 bool GameState::operator==(const GameState& other) {
@@ -139,143 +275,173 @@ bool GameState::operator==(const GameState& other) {
 			isBlack == other.isBlack;
 }
 
-void GameState::MakeMove(const Move& move) {
-	isBlack = !isBlack;
-	castlingRights = castlingRights & ~((move.KingSideCastle()  ? (isBlack ? 0b1000 : 0b0010) : 0) | (move.QueenSideCastle() ? (isBlack ? 0b0100 : 0b0001) : 0));
-	halfClock++;
-	!isBlack ? clock++ : 0;
-	capturedPieceType = NoPiece;
+// Rights that survive a piece moving from or to each square. Anything leaving or landing on a king or rook's
+// home square costs that side the matching right, which covers king moves, rook moves & rooks being captured.
+static constexpr std::array<uint8_t, 64> GCastlingMasks() {
+	std::array<uint8_t, 64> masks {};
+	for (int square = 0; square < 64; square++) {
+		masks[square] = 0b1111;
+	}
+	masks[0]  = (uint8_t)~0b0100; // a1, Q
+	masks[7]  = (uint8_t)~0b1000; // h1, K
+	masks[4]  = (uint8_t)~0b1100; // e1, KQ
+	masks[56] = (uint8_t)~0b0001; // a8, q
+	masks[63] = (uint8_t)~0b0010; // h8, k
+	masks[60] = (uint8_t)~0b0011; // e8, kq
+	return masks;
+}
 
-	uint8_t from = move.getFrom();
-	uint8_t to   = move.getTo();
-	
-	ChessPiece piece = bits.PieceFromIndex(from);
-	ChessPiece target = bits.PieceFromIndex(to);
-	bool capture = (target != NoPiece);
+static constexpr std::array<uint8_t, 64> CastlingMasks = GCastlingMasks();
 
-	if ((piece & 7) == ChessPiece::King) {
-		friendlyKingSquare = to;
-		castlingRights &= !isBlack ? ~0b0011 : ~0b1100;
+static ChessPiece promotionPiece(const Move& move) {
+	switch (move.getFlags() & Move::FlagCodes::Promotion) {
+		case Move::FlagCodes::ToKnight: return ChessPiece::Knight;
+		case Move::FlagCodes::ToRook:   return ChessPiece::Rook;
+		case Move::FlagCodes::ToBishop: return ChessPiece::Bishop;
+		default:                        return ChessPiece::Queen;
+	}
+}
 
-		if (move.isCastle()) {
-			const uint8_t offset = !isBlack ? 56 : 0;
-			const uint8_t originalRookSquare = (move.QueenSideCastle() ? 0 : 7) + offset;
-			const uint8_t movedRookSquare    = (move.QueenSideCastle() ? 3 : 5) + offset;
+static inline uint64_t pawnSquareKey(const ChessPiece pawn, const uint8_t square) {
+	return Zobrist::keys.pieces[(pawn & ChessPiece::Black) ? 6 : 0][square];
+}
 
-			const ChessPiece lookup = (ChessPiece)(ChessPiece::Rook | (!isBlack << 3));
+static inline uint64_t pieceSquareKey(const ChessPiece piece, const uint8_t square) {
+	return Zobrist::keys.pieces[(piece & 7) - 1 + ((piece & ChessPiece::Black) ? 6 : 0)][square];
+}
 
-			bits.enable(lookup, movedRookSquare);
-			bits.disable(lookup, originalRookSquare);
-		}
-	} else if ((piece & 7) == ChessPiece::Pawn) {
-		halfClock = 0;
-	}
+// castling rights & en passant square, the parts of the key that get swapped out wholesale every move.
+static inline uint64_t rightsKey(const uint8_t castling, const uint8_t enPassant) {
+	return Zobrist::keys.castling[castling & 15] ^ (enPassant < 64 ? Zobrist::keys.enPassant[enPassant & 7] : 0);
+}
 
-	// Swapping King pos after King moves so we don't accidentally overwrite the wrong king position.
-	uint8_t temp = friendlyKingSquare;
-	friendlyKingSquare = enemyKingSquare;
-	enemyKingSquare = temp;
+void GameState::setCastlingRights(const uint8_t rights) {
+	key ^= Zobrist::keys.castling[castlingRights] ^ Zobrist::keys.castling[rights & 15];
+	castlingRights = rights;
+}
 
-	// not updated enPassantSquare yet so still "old" move.
-	if (to == enPassantSquare) {
-		halfClock = 0;
-		uint8_t offset = piece & 8 ? (to + 8) : to - 8;
-		bits.disable((ChessPiece)(piece ^ (1U << 3)), offset);
-		capturedPieceType = Pawn;
-	} else if (capture) {
+void GameState::MakeMove(const Move& move) {
+	const uint8_t from = move.getFrom();
+	const uint8_t to   = move.getTo();
+
+	const ChessPiece piece  = bits.PieceFromIndex(from);
+	const ChessPiece target = bits.PieceFromIndex(to);
+	const uint8_t colour = piece & ChessPiece::Black;
+
+	halfClock++;
+	capturedPieceType = target;
+	key ^= rightsKey(castlingRights, enPassantSquare);
+	if (target != NoPiece) {
 		halfClock = 0;
-		capturedPieceType = target;
 		bits.disable(target, to);
+		key ^= pieceSquareKey(target, to);
+		if ((target & 7) == ChessPiece::Pawn) {
+			pawnKey ^= pawnSquareKey(target, to);
+		}
+	}
 
-		if (to == 56 || to == 0) {
-			castlingRights &= isBlackTurn() ? ~0b0001 : ~0b0100;
-		} else if (to == 63 || to == 7) {
-			castlingRights &= isBlackTurn() ? ~0b0010 : ~0b1000;
+	if ((piece & 7) == ChessPiece::Pawn) {
+		halfClock = 0;
+		pawnKey ^= pawnSquareKey(piece, from);
+		if (!move.isPromotion()) {
+			pawnKey ^= pawnSquareKey(piece, to);
 		}
-	} else if (move.isPromotion()) {
-		ChessPiece newPiece;
-		switch(move.getFlags() & Move::FlagCodes::Promotion) {
-			case Move::FlagCodes::ToQueen:
-				newPiece = ChessPiece::Queen;
-				break;
-			case Move::FlagCodes::ToKnight:
-				newPiece = ChessPiece::Knight;
-				break;
-			case Move::FlagCodes::ToRook:
-				newPiece = ChessPiece::Rook;
-				break;
-			case Move::FlagCodes::ToBishop:
-				newPiece = ChessPiece::Bishop;
-				break;
+		// not updated enPassantSquare yet so still "old" move.
+		if (to == enPassantSquare) {
+			const uint8_t captureSquare = colour ? to + 8 : to - 8;
+			capturedPieceType = (ChessPiece)(ChessPiece::Pawn | (colour ^ ChessPiece::Black));
+			bits.disable(capturedPieceType, captureSquare);
+			key ^= pieceSquareKey(capturedPieceType, captureSquare);
+			pawnKey ^= pawnSquareKey(capturedPieceType, captureSquare);
+		}
+	} else if ((piece & 7) == ChessPiece::King) {
+		friendlyKingSquare = to;
+
+		if (move.isCastle()) {
+			const uint8_t offset = colour ? 56 : 0;
+			const uint8_t originalRookSquare = (move.QueenSideCastle() ? 0 : 7) + offset;
+			const uint8_t movedRookSquare    = (move.QueenSideCastle() ? 3 : 5) + offset;
+
+			const ChessPiece rook = (ChessPiece)(ChessPiece::Rook | colour);
+			bits.enable(rook, movedRookSquare);
+			bits.disable(rook, originalRookSquare);
+			key ^= pieceSquareKey(rook, movedRookSquare) ^ pieceSquareKey(rook, originalRookSquare);
 		}
-		bits.disable((ChessPiece)(Pawn | (!isBlack << 3)), to);
-		bits.enable((ChessPiece)(newPiece | (!isBlack << 3)), to);
 	}
 
-	// We do these at the end now, b/c we can't rely on there being an old board to reference.
-	bits.enable(piece, to);
+	const ChessPiece placed = move.isPromotion() ? (ChessPiece)(promotionPiece(move) | colour) : piece;
 	bits.disable(piece, from);
-	enPassantSquare = move.isDoublePush() ? (move.getTo() + (isBlack ? -8 : 8)) : 255;
+	bits.enable(placed, to);
+	key ^= pieceSquareKey(piece, from) ^ pieceSquareKey(placed, to);
+
+	castlingRights &= CastlingMasks[from] & CastlingMasks[to];
+	enPassantSquare = move.isDoublePush() ? (from + to) / 2 : 255;
+	key ^= rightsKey(castlingRights, enPassantSquare) ^ Zobrist::keys.side;
+	if (isBlack) {
+		clock++;
+	}
+	isBlack = !isBlack;
+
+	// the side to move flipped, so friendly & enemy swap too. (bitfields, so no std::swap)
+	const uint8_t temp = friendlyKingSquare;
+	friendlyKingSquare = enemyKingSquare;
+	enemyKingSquare = temp;
 }
 
-#include <cassert>
 void GameState::UnmakeMove(const Move& move, const GameStateMemory& memory) {
-	uint8_t temp = friendlyKingSquare;
+	const uint8_t temp = friendlyKingSquare;
 	friendlyKingSquare = enemyKingSquare;
 	enemyKingSquare = temp;
-
-	// for now, we shouldn't worry about undoing fifty move counter.
 	isBlack = !isBlack;
-	bool undoingBlackMove = isBlack;
+	if (isBlack) {
+		clock--;
+	}
 
 	const uint8_t from = move.getFrom();
-	const uint8_t to = move.getTo();
-
-	// I'm concerned about undoing & restoring EnPassant for a previous move. Perhaps it would pay to keep previous EnPassant square around?
-	bool undoingEnCapture	= move.isEnCapture();
-	bool undoingPromotion	= move.isPromotion();
-	bool undoingCapture     = (capturedPieceType != NoPiece);
-
-	const ChessPiece mover = bits.PieceFromIndex(to);
+	const uint8_t to   = move.getTo();
+	const uint8_t colour = isBlack ? ChessPiece::Black : 0;
+
+	const ChessPiece moved = bits.PieceFromIndex(to);
+	const ChessPiece original = move.isPromotion() ? (ChessPiece)(ChessPiece::Pawn | colour) : moved;
+	bits.disable(moved, to);
+	bits.enable(original, from);
+	key ^= pieceSquareKey(moved, to) ^ pieceSquareKey(original, from) ^ Zobrist::keys.side;
+	// xor is its own inverse, so the pawn key comes back by toggling the same squares MakeMove did.
+	if (move.isPromotion()) {
+		pawnKey ^= pawnSquareKey((ChessPiece)(ChessPiece::Pawn | colour), from);
+	} else if ((moved & 7) == ChessPiece::Pawn) {
+		pawnKey ^= pawnSquareKey(moved, from) ^ pawnSquareKey(moved, to);
+	}
 
-	if ((mover & 7) == ChessPiece::King) {
+	if ((moved & 7) == ChessPiece::King) {
 		friendlyKingSquare = from;
+
 		if (move.isCastle()) {
-			const uint8_t offset = undoingBlackMove ? 56 : 0;
+			const uint8_t offset = colour ? 56 : 0;
 			const uint8_t originalRookSquare = (move.QueenSideCastle() ? 0 : 7) + offset;
 			const uint8_t movedRookSquare    = (move.QueenSideCastle() ? 3 : 5) + offset;
 
-			const ChessPiece rook = undoingBlackMove ? (ChessPiece)(Rook | Black) : Rook;
+			const ChessPiece rook = (ChessPiece)(ChessPiece::Rook | colour);
 			bits.enable(rook, originalRookSquare);
 			bits.disable(rook, movedRookSquare);
+			key ^= pieceSquareKey(rook, movedRookSquare) ^ pieceSquareKey(rook, originalRookSquare);
 		}
 	}
 
-	if (undoingCapture) {
-		uint8_t captureSquare = to;
-		if (undoingEnCapture) {
-			captureSquare = to + ((undoingBlackMove) ? 8 : -8);
-			enPassantSquare = captureSquare;
-		} else {
-			enPassantSquare = 255;
-		}
-
+	if (capturedPieceType != NoPiece) {
+		// an en passant capture took the pawn from behind the target square.
+		const bool enCapture = to == memory.enPassantSquare && (moved & 7) == ChessPiece::Pawn;
+		const uint8_t captureSquare = enCapture ? (colour ? to + 8 : to - 8) : to;
 		bits.enable(capturedPieceType, captureSquare);
+		key ^= pieceSquareKey(capturedPieceType, captureSquare);
+		if ((capturedPieceType & 7) == ChessPiece::Pawn) {
+			pawnKey ^= pawnSquareKey(capturedPieceType, captureSquare);
+		}
 	}
 
-	bits.disable(mover, to);
-	bits.enable(mover, from);
-	if (undoingPromotion) {
-		bits.enable((ChessPiece)(Pawn | (!undoingBlackMove << 3)), from);
-	}
-
-	// Originally was using an internal stack to handle this, but was encountering some very strange bugs w/ popping causing
-	// crashes. May be worth investigating that eventually, but this is an acceptable solution for now.
-
+	key ^= rightsKey(castlingRights, enPassantSquare) ^ rightsKey(memory.castlingRights, memory.enPassantSquare);
 	capturedPieceType = memory.capturedPieceType;
-	castlingRights = memory.castlingRights;
-	halfClock = memory.halfClock;
-	clock -= undoingBlackMove ? 1 : 0;
-
-	//assert(friendlyKingSquare != 11);
+	castlingRights    = memory.castlingRights;
+	halfClock         = memory.halfClock;
+	enPassantSquare   = memory.enPassantSquare;
 }
\ No newline at end of file
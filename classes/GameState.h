@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <stack>
+#include <string>
+#include <string_view>
 
 #include "MagicBitboards/ProtoBoard.h"
 #include "Move.h"
@@ -10,16 +12,18 @@
 // https://www.chessprogramming.org/Repetitions
 // http://www.open-chess.org/viewtopic.php?f=3&t=2209
 
-// 2 bytes... safe to pack.
-// Keeps track of disposable memory.
+// 4 bytes... safe to pack.
+// Keeps track of disposable memory, everything MakeMove can't work backwards from.
 #pragma pack(push, 1)
 struct GameStateMemory {
 	uint8_t halfClock;
 	// 4 bits in reality, but to pack efficently on all systems, half a byte screws with this.
 	uint8_t castlingRights;
 	ChessPiece capturedPieceType;
+	uint8_t enPassantSquare;
 
-	GameStateMemory(uint8_t hc, uint8_t cr, ChessPiece cpt) : halfClock(hc), castlingRights(cr), capturedPieceType(cpt) {}
+	GameStateMemory() = default;
+	GameStateMemory(uint8_t hc, uint8_t cr, ChessPiece cpt, uint8_t ep) : halfClock(hc), castlingRights(cr), capturedPieceType(cpt), enPassantSquare(ep) {}
 };
 #pragma pack(pop)
 
@@ -33,9 +37,16 @@ class GameState {
 	// generate next move
 	GameState(const GameState& old, const Move& move);
 
-	GameState(const GameState& old);
+	GameState(const GameState& old) = default;
+	GameState& operator=(const GameState&) = default;
 
-	GameState& operator=(const GameState&);
+	// Parses the board & game state out of a FEN (or EPD) string without allocating.
+	// Throws on anything malformed: bad ranks, unknown symbols, missing or extra kings, bad castling/ep fields.
+	static GameState FromFEN(const std::string_view fen);
+	// Writes state as FEN into buffer, which needs room for MAX_FEN_LENGTH chars. Returns the length, not counting the null.
+	static size_t ToFEN(const GameState& state, char* buffer);
+	// 71 for the board, 10 for side/castling/ep & their spaces (" w KQkq e3"), 11 for the clocks & the null (" 255 65535\0").
+	static const size_t MAX_FEN_LENGTH = 92;
 	bool operator==(const GameState&);
 
 	void MakeMove(const Move&);
@@ -46,7 +57,7 @@ class GameState {
 
 	GameStateMemory makeMemoryState() {
 		// hoping RVO kicks in.
-		GameStateMemory memory = GameStateMemory(halfClock, castlingRights, capturedPieceType);
+		GameStateMemory memory = GameStateMemory(halfClock, castlingRights, capturedPieceType, enPassantSquare);
 		return memory;
 	}
 
@@ -60,9 +71,14 @@ class GameState {
 	uint8_t getCastlingRights()	const { return castlingRights; }
 	uint8_t getHalfClock()		const { return halfClock; }
 	uint16_t getClock() const { return clock; }
-	void setCastlingRights(const uint8_t rights) { castlingRights = rights; }
+	// Zobrist key of the whole position, same as Zobrist::computeKey but kept up to date by make/unmake.
+	uint64_t getKey() const { return key; }
+	// Zobrist key of just the pawns, see Zobrist::computePawnKey.
+	uint64_t getPawnKey() const { return pawnKey; }
+	void setCastlingRights(const uint8_t rights);
 	// consider not allowing direct access to protoboard
 	ProtoBoard& getProtoBoard() { return bits; }
+	const ProtoBoard& getProtoBoard() const { return bits; }
 
 	uint8_t getEnemyKingSquare()    const { return enemyKingSquare; }
 	uint8_t getFriendlyKingSquare() const { return friendlyKingSquare; }
@@ -83,9 +99,10 @@ class GameState {
 	uint8_t castlingRights : 4; // KQkq
 	// FOR FUTURE SELF: I am not capping this b/c I need an easy to check null value (ex, 255)
 	uint8_t enPassantSquare;
-	uint8_t halfClock : 6;
+	uint8_t halfClock;
 	uint16_t clock;
-	//const uint64_t hash;
+	uint64_t key;
+	uint64_t pawnKey;
 	uint8_t friendlyKingSquare : 6;
 	uint8_t enemyKingSquare : 6;
 	ChessPiece capturedPieceType;
@@ -0,0 +1,124 @@
+#include <vector>
+
+#include "KPKBitbase.h"
+#include "MagicBitboards/PieceAttacks.h"
+#include "MagicBitboards/BitFunctions.h"
+
+namespace KPK {
+	// Pawn can only be on ranks 2-7 & (after mirroring) files a-d, which leaves 24 squares.
+	const unsigned MAX_INDEX = 2 * 24 * 64 * 64;
+
+	// Results double as bit flags so we can OR successors together while classifying.
+	enum Result : uint8_t {
+		Invalid = 0,
+		Unknown = 1,
+		Draw    = 2,
+		Win     = 4
+	};
+
+	static uint32_t bitbase[MAX_INDEX / 32];
+
+	// bits 0-5: white king, 6-11: black king, 12: side to move, 13-14: pawn file, 15-17: 7th rank - pawn rank
+	static inline unsigned index(const bool blackToMove, const uint8_t blackKing, const uint8_t whiteKing, const uint8_t pawn) {
+		return whiteKing | (blackKing << 6) | (blackToMove << 12) | ((pawn % 8) << 13) | ((6 - pawn / 8) << 15);
+	}
+
+	static inline bool adjacent(const uint8_t a, const uint8_t b) {
+		return (KingAttacks[a] >> b) & 1;
+	}
+
+	static Result initialResult(const unsigned idx) {
+		const uint8_t whiteKing = idx & 63;
+		const uint8_t blackKing = (idx >> 6) & 63;
+		const bool blackToMove  = (idx >> 12) & 1;
+		const uint8_t pawn      = ((idx >> 13) & 3) + (6 - ((idx >> 15) & 7)) * 8;
+		const uint64_t blackKingBit = 1ULL << blackKing;
+		const uint8_t pushSquare = pawn + 8;
+
+		// kings touching, pieces sharing squares, or black in check with white to move.
+		if (whiteKing == blackKing || adjacent(whiteKing, blackKing) || whiteKing == pawn || blackKing == pawn
+			|| (!blackToMove && (PawnAttacks[pawn][0] & blackKingBit))) {
+			return Invalid;
+		}
+
+		// pawn promotes and the new queen can't be taken.
+		if (!blackToMove && pawn / 8 == 6 && whiteKing != pushSquare
+			&& ((blackKing != pushSquare && !adjacent(blackKing, pushSquare)) || adjacent(whiteKing, pushSquare))) {
+			return Win;
+		}
+
+		// stalemate, or black can grab an undefended pawn.
+		if (blackToMove) {
+			const uint64_t escapes = KingAttacks[blackKing] & ~(KingAttacks[whiteKing] | PawnAttacks[pawn][0]);
+			const bool pawnHangs = (KingAttacks[blackKing] & ~KingAttacks[whiteKing] & (1ULL << pawn)) != 0;
+			if (escapes == 0 || pawnHangs) {
+				return Draw;
+			}
+		}
+
+		return Unknown;
+	}
+
+	// White wins if any move wins, black draws if any move draws.
+	static Result classify(const std::vector<uint8_t>& db, const unsigned idx) {
+		const uint8_t whiteKing = idx & 63;
+		const uint8_t blackKing = (idx >> 6) & 63;
+		const bool blackToMove  = (idx >> 12) & 1;
+		const uint8_t pawn      = ((idx >> 13) & 3) + (6 - ((idx >> 15) & 7)) * 8;
+
+		const Result good = blackToMove ? Draw : Win;
+		const Result bad  = blackToMove ? Win  : Draw;
+
+		uint8_t r = Invalid;
+		forEachBit([&](uint8_t to) {
+			r |= blackToMove ? db[index(false, to, whiteKing, pawn)] : db[index(true, blackKing, to, pawn)];
+		}, KingAttacks[blackToMove ? blackKing : whiteKing]);
+
+		if (!blackToMove) {
+			// promotion is already handled as a starting result, so pushes only go up to the 7th.
+			if (pawn / 8 < 6) {
+				r |= db[index(true, blackKing, whiteKing, pawn + 8)];
+			}
+			if (pawn / 8 == 1 && pawn + 8 != whiteKing && pawn + 8 != blackKing) {
+				r |= db[index(true, blackKing, whiteKing, pawn + 16)];
+			}
+		}
+
+		return (r & good) ? good : (r & Unknown) ? Unknown : bad;
+	}
+
+	void init() {
+		std::vector<uint8_t> db(MAX_INDEX);
+		for (unsigned idx = 0; idx < MAX_INDEX; idx++) {
+			db[idx] = initialResult(idx);
+		}
+
+		// keep sweeping until nothing changes; anything still unknown afterwards is a draw.
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			for (unsigned idx = 0; idx < MAX_INDEX; idx++) {
+				if (db[idx] != Unknown) continue;
+
+				const Result r = classify(db, idx);
+				if (r != Unknown) {
+					db[idx] = r;
+					changed = true;
+				}
+			}
+		}
+
+		for (unsigned idx = 0; idx < MAX_INDEX; idx++) {
+			if (db[idx] == Win) {
+				bitbase[idx / 32] |= 1U << (idx % 32);
+			} else {
+				bitbase[idx / 32] &= ~(1U << (idx % 32));
+			}
+		}
+	}
+
+	bool probe(const uint8_t whiteKing, const uint8_t whitePawn, const uint8_t blackKing, const bool blackToMove) {
+		const unsigned idx = index(blackToMove, blackKing, whiteKing, whitePawn);
+		return (bitbase[idx / 32] >> (idx % 32)) & 1;
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+// King + Pawn vs King win/draw bitbase, built by retrograde analysis when the engine starts.
+// One bit per position (2 sides * 24 pawn squares * 64 * 64 king squares), so the whole thing is 24KB.
+// https://www.chessprogramming.org/KPK
+namespace KPK {
+	// Builds the bitbase. Takes a few milliseconds; call once before probing.
+	void init();
+
+	// Probes with white as the side that owns the pawn, and the pawn on files a-d.
+	// Returns true if white wins with best play, false if it's a draw.
+	bool probe(const uint8_t whiteKing, const uint8_t whitePawn, const uint8_t blackKing, const bool blackToMove);
+}
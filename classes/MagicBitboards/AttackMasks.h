@@ -2,167 +2,110 @@
 #define ATTACK_MASKS_H
 
 #include <stdint.h>
+#include <array>
+
+// Walks from square in one direction until the edge of the board. If trimEdge is set, the last square before
+// the edge is left off, since a blocker sitting on the edge never changes a slider's attacks.
+constexpr uint64_t GRay(int square, int dRank, int dFile, bool trimEdge) {
+    uint64_t ray = 0;
+    int r = square / 8 + dRank;
+    int f = square % 8 + dFile;
+
+    while (r >= 0 && r < 8 && f >= 0 && f < 8) {
+        int nr = r + dRank;
+        int nf = f + dFile;
+        if (trimEdge && !(nr >= 0 && nr < 8 && nf >= 0 && nf < 8)) {
+            break;
+        }
+        ray |= 1ULL << (r * 8 + f);
+        r = nr;
+        f = nf;
+    }
+
+    return ray;
+}
+
+constexpr std::array<uint64_t, 64> GRookMasks() {
+    std::array<uint64_t, 64> masks {};
+    for (int square = 0; square < 64; square++) {
+        masks[square] = GRay(square, 1, 0, true) | GRay(square, -1, 0, true)
+                      | GRay(square, 0, 1, true) | GRay(square, 0, -1, true);
+    }
+    return masks;
+}
+
+constexpr std::array<uint64_t, 64> GBishopMasks() {
+    std::array<uint64_t, 64> masks {};
+    for (int square = 0; square < 64; square++) {
+        masks[square] = GRay(square, 1, 1, true)  | GRay(square, -1, 1, true)
+                      | GRay(square, -1, -1, true) | GRay(square, 1, -1, true);
+    }
+    return masks;
+}
 
 // Attack masks for rooks
-const uint64_t RMasks[64] = {
-    0x101010101017eULL, 0x202020202027cULL, 0x404040404047aULL, 0x8080808080876ULL,
-    0x1010101010106eULL, 0x2020202020205eULL, 0x4040404040403eULL, 0x8080808080807eULL,
-    0x1010101017e00ULL, 0x2020202027c00ULL, 0x4040404047a00ULL, 0x8080808087600ULL,
-    0x10101010106e00ULL, 0x20202020205e00ULL, 0x40404040403e00ULL, 0x80808080807e00ULL,
-    0x10101017e0100ULL, 0x20202027c0200ULL, 0x40404047a0400ULL, 0x8080808760800ULL,
-    0x101010106e1000ULL, 0x202020205e2000ULL, 0x404040403e4000ULL, 0x808080807e8000ULL,
-    0x101017e010100ULL, 0x202027c020200ULL, 0x404047a040400ULL, 0x8080876080800ULL,
-    0x1010106e101000ULL, 0x2020205e202000ULL, 0x4040403e404000ULL, 0x8080807e808000ULL,
-    0x1017e01010100ULL, 0x2027c02020200ULL, 0x4047a04040400ULL, 0x8087608080800ULL,
-    0x10106e10101000ULL, 0x20205e20202000ULL, 0x40403e40404000ULL, 0x80807e80808000ULL,
-    0x17e0101010100ULL, 0x27c0202020200ULL, 0x47a0404040400ULL, 0x8760808080800ULL,
-    0x106e1010101000ULL, 0x205e2020202000ULL, 0x403e4040404000ULL, 0x807e8080808000ULL,
-    0x7e010101010100ULL, 0x7c020202020200ULL, 0x7a040404040400ULL, 0x76080808080800ULL,
-    0x6e101010101000ULL, 0x5e202020202000ULL, 0x3e404040404000ULL, 0x7e808080808000ULL,
-    0x7e01010101010100ULL, 0x7c02020202020200ULL, 0x7a04040404040400ULL, 0x7608080808080800ULL,
-    0x6e10101010101000ULL, 0x5e20202020202000ULL, 0x3e40404040404000ULL, 0x7e80808080808000ULL
-};
+inline constexpr std::array<uint64_t, 64> RMasks = GRookMasks();
 
 // Attack masks for bishops
-const uint64_t BMasks[64] = {
-    0x40201008040200ULL, 0x402010080400ULL, 0x4020100a00ULL, 0x40221400ULL,
-    0x2442800ULL, 0x204085000ULL, 0x20408102000ULL, 0x2040810204000ULL,
-    0x20100804020000ULL, 0x40201008040000ULL, 0x4020100a0000ULL, 0x4022140000ULL,
-    0x244280000ULL, 0x20408500000ULL, 0x2040810200000ULL, 0x4081020400000ULL,
-    0x10080402000200ULL, 0x20100804000400ULL, 0x4020100a000a00ULL, 0x402214001400ULL,
-    0x24428002800ULL, 0x2040850005000ULL, 0x4081020002000ULL, 0x8102040004000ULL,
-    0x8040200020400ULL, 0x10080400040800ULL, 0x20100a000a1000ULL, 0x40221400142200ULL,
-    0x2442800284400ULL, 0x4085000500800ULL, 0x8102000201000ULL, 0x10204000402000ULL,
-    0x4020002040800ULL, 0x8040004081000ULL, 0x100a000a102000ULL, 0x22140014224000ULL,
-    0x44280028440200ULL, 0x8500050080400ULL, 0x10200020100800ULL, 0x20400040201000ULL,
-    0x2000204081000ULL, 0x4000408102000ULL, 0xa000a10204000ULL, 0x14001422400000ULL,
-    0x28002844020000ULL, 0x50005008040200ULL, 0x20002010080400ULL, 0x40004020100800ULL,
-    0x20408102000ULL, 0x40810204000ULL, 0xa1020400000ULL, 0x142240000000ULL,
-    0x284402000000ULL, 0x500804020000ULL, 0x201008040200ULL, 0x402010080400ULL,
-    0x2040810204000ULL, 0x4081020400000ULL, 0xa102040000000ULL, 0x14224000000000ULL,
-    0x28440200000000ULL, 0x50080402000000ULL, 0x20100804020000ULL, 0x40201008040200ULL
-};
-
-const uint64_t ColinearMask[64][64] = {
-    {0x1, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x101010101010101, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x101010101010101, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x101010101010101, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x101010101010101, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x101010101010101, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x101010101010101, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x101010101010101, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201},
-    {0xff, 0x2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x102, 0x202020202020202, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x102, 0x202020202020202, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x102, 0x202020202020202, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x102, 0x202020202020202, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x102, 0x202020202020202, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x102, 0x202020202020202, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x102, 0x202020202020202, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402},
-    {0xff, 0xff, 0x4, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10204, 0x10204, 0x404040404040404, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x10204, 0x10204, 0x404040404040404, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x10204, 0x10204, 0x404040404040404, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x10204, 0x10204, 0x404040404040404, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x10204, 0x10204, 0x404040404040404, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x10204, 0x10204, 0x404040404040404, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x10204, 0x10204, 0x404040404040404, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804},
-    {0xff, 0xff, 0xff, 0x8, 0xff, 0xff, 0xff, 0xff, 0x1020408, 0x1020408, 0x1020408, 0x808080808080808, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x1020408, 0x1020408, 0x1020408, 0x808080808080808, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x1020408, 0x1020408, 0x1020408, 0x808080808080808, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x1020408, 0x1020408, 0x1020408, 0x808080808080808, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x1020408, 0x1020408, 0x1020408, 0x808080808080808, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x1020408, 0x1020408, 0x1020408, 0x808080808080808, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x1020408, 0x1020408, 0x1020408, 0x808080808080808, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008},
-    {0xff, 0xff, 0xff, 0xff, 0x10, 0xff, 0xff, 0xff, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x1010101010101010, 0x80402010, 0x80402010, 0x80402010, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x1010101010101010, 0x80402010, 0x80402010, 0x80402010, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x1010101010101010, 0x80402010, 0x80402010, 0x80402010, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x1010101010101010, 0x80402010, 0x80402010, 0x80402010, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x1010101010101010, 0x80402010, 0x80402010, 0x80402010, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x1010101010101010, 0x80402010, 0x80402010, 0x80402010, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x1010101010101010, 0x80402010, 0x80402010, 0x80402010},
-    {0xff, 0xff, 0xff, 0xff, 0xff, 0x20, 0xff, 0xff, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x2020202020202020, 0x804020, 0x804020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x2020202020202020, 0x804020, 0x804020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x2020202020202020, 0x804020, 0x804020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x2020202020202020, 0x804020, 0x804020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x2020202020202020, 0x804020, 0x804020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x2020202020202020, 0x804020, 0x804020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x2020202020202020, 0x804020, 0x804020},
-    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x40, 0xff, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x4040404040404040, 0x8040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x4040404040404040, 0x8040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x4040404040404040, 0x8040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x4040404040404040, 0x8040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x4040404040404040, 0x8040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x4040404040404040, 0x8040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x4040404040404040, 0x8040},
-    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x8080808080808080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x8080808080808080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x8080808080808080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x8080808080808080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x8080808080808080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x8080808080808080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x8080808080808080},
-    {0x101010101010101, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x100, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0x101010101010101, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x101010101010101, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x101010101010101, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x101010101010101, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x101010101010101, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x101010101010101, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100},
-    {0x8040201008040201, 0x202020202020202, 0x10204, 0x10204, 0x10204, 0x10204, 0x10204, 0x10204, 0xff00, 0x200, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0x10204, 0x202020202020202, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x10204, 0x202020202020202, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x10204, 0x202020202020202, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x10204, 0x202020202020202, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x10204, 0x202020202020202, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x10204, 0x202020202020202, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201},
-    {0x80402010080402, 0x80402010080402, 0x404040404040404, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0xff00, 0xff00, 0x400, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0x1020408, 0x1020408, 0x404040404040404, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x1020408, 0x1020408, 0x404040404040404, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x1020408, 0x1020408, 0x404040404040404, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x1020408, 0x1020408, 0x404040404040404, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x1020408, 0x1020408, 0x404040404040404, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x1020408, 0x1020408, 0x404040404040404, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402},
-    {0x804020100804, 0x804020100804, 0x804020100804, 0x808080808080808, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0xff00, 0xff00, 0xff00, 0x800, 0xff00, 0xff00, 0xff00, 0xff00, 0x102040810, 0x102040810, 0x102040810, 0x808080808080808, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x102040810, 0x102040810, 0x102040810, 0x808080808080808, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x102040810, 0x102040810, 0x102040810, 0x808080808080808, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x102040810, 0x102040810, 0x102040810, 0x808080808080808, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x102040810, 0x102040810, 0x102040810, 0x808080808080808, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x102040810, 0x102040810, 0x102040810, 0x808080808080808, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804},
-    {0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x1010101010101010, 0x10204081020, 0x10204081020, 0x10204081020, 0xff00, 0xff00, 0xff00, 0xff00, 0x1000, 0xff00, 0xff00, 0xff00, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x1010101010101010, 0x8040201008, 0x8040201008, 0x8040201008, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x1010101010101010, 0x8040201008, 0x8040201008, 0x8040201008, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x1010101010101010, 0x8040201008, 0x8040201008, 0x8040201008, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x1010101010101010, 0x8040201008, 0x8040201008, 0x8040201008, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x1010101010101010, 0x8040201008, 0x8040201008, 0x8040201008, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x1010101010101010, 0x8040201008, 0x8040201008, 0x8040201008},
-    {0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x2020202020202020, 0x1020408102040, 0x1020408102040, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0x2000, 0xff00, 0xff00, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x2020202020202020, 0x80402010, 0x80402010, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x2020202020202020, 0x80402010, 0x80402010, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x2020202020202020, 0x80402010, 0x80402010, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x2020202020202020, 0x80402010, 0x80402010, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x2020202020202020, 0x80402010, 0x80402010, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x2020202020202020, 0x80402010, 0x80402010},
-    {0x804020, 0x804020, 0x804020, 0x804020, 0x804020, 0x804020, 0x4040404040404040, 0x102040810204080, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0x4000, 0xff00, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x4040404040404040, 0x804020, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x4040404040404040, 0x804020, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x4040404040404040, 0x804020, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x4040404040404040, 0x804020, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x4040404040404040, 0x804020, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x4040404040404040, 0x804020},
-    {0x8040, 0x8040, 0x8040, 0x8040, 0x8040, 0x8040, 0x8040, 0x8080808080808080, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0xff00, 0x8000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x8080808080808080, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x8080808080808080, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x8080808080808080, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x8080808080808080, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x8080808080808080, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x8080808080808080},
-    {0x101010101010101, 0x10204, 0x10204, 0x10204, 0x10204, 0x10204, 0x10204, 0x10204, 0x101010101010101, 0x10204, 0x10204, 0x10204, 0x10204, 0x10204, 0x10204, 0x10204, 0x10000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0x101010101010101, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x101010101010101, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x101010101010101, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x101010101010101, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x101010101010101, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000},
-    {0x4020100804020100, 0x202020202020202, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x4020100804020100, 0x202020202020202, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0xff0000, 0x20000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0x1020408, 0x202020202020202, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x1020408, 0x202020202020202, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x1020408, 0x202020202020202, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x1020408, 0x202020202020202, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x1020408, 0x202020202020202, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100},
-    {0x8040201008040201, 0x8040201008040201, 0x404040404040404, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x8040201008040201, 0x8040201008040201, 0x404040404040404, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0xff0000, 0xff0000, 0x40000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0x102040810, 0x102040810, 0x404040404040404, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x102040810, 0x102040810, 0x404040404040404, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x102040810, 0x102040810, 0x404040404040404, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x102040810, 0x102040810, 0x404040404040404, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x102040810, 0x102040810, 0x404040404040404, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201},
-    {0x80402010080402, 0x80402010080402, 0x80402010080402, 0x808080808080808, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x808080808080808, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0xff0000, 0xff0000, 0xff0000, 0x80000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0x10204081020, 0x10204081020, 0x10204081020, 0x808080808080808, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x10204081020, 0x10204081020, 0x10204081020, 0x808080808080808, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x10204081020, 0x10204081020, 0x10204081020, 0x808080808080808, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x10204081020, 0x10204081020, 0x10204081020, 0x808080808080808, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x10204081020, 0x10204081020, 0x10204081020, 0x808080808080808, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402},
-    {0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x1010101010101010, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x1010101010101010, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0x100000, 0xff0000, 0xff0000, 0xff0000, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1010101010101010, 0x804020100804, 0x804020100804, 0x804020100804, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1010101010101010, 0x804020100804, 0x804020100804, 0x804020100804, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1010101010101010, 0x804020100804, 0x804020100804, 0x804020100804, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1010101010101010, 0x804020100804, 0x804020100804, 0x804020100804, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1010101010101010, 0x804020100804, 0x804020100804, 0x804020100804},
-    {0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x2020202020202020, 0x102040810204080, 0x102040810204080, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x2020202020202020, 0x102040810204080, 0x102040810204080, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0x200000, 0xff0000, 0xff0000, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x2020202020202020, 0x8040201008, 0x8040201008, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x2020202020202020, 0x8040201008, 0x8040201008, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x2020202020202020, 0x8040201008, 0x8040201008, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x2020202020202020, 0x8040201008, 0x8040201008, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x2020202020202020, 0x8040201008, 0x8040201008},
-    {0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x4040404040404040, 0x204081020408000, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x4040404040404040, 0x204081020408000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0x400000, 0xff0000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x4040404040404040, 0x80402010, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x4040404040404040, 0x80402010, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x4040404040404040, 0x80402010, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x4040404040404040, 0x80402010, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x4040404040404040, 0x80402010},
-    {0x804020, 0x804020, 0x804020, 0x804020, 0x804020, 0x804020, 0x804020, 0x8080808080808080, 0x804020, 0x804020, 0x804020, 0x804020, 0x804020, 0x804020, 0x804020, 0x8080808080808080, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0xff0000, 0x800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x8080808080808080, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x8080808080808080, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x8080808080808080, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x8080808080808080, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x8080808080808080},
-    {0x101010101010101, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x101010101010101, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x101010101010101, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1020408, 0x1000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x101010101010101, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x101010101010101, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x101010101010101, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x101010101010101, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000},
-    {0x2010080402010000, 0x202020202020202, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x2010080402010000, 0x202020202020202, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x2010080402010000, 0x202020202020202, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0xff000000, 0x2000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x102040810, 0x202020202020202, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x102040810, 0x202020202020202, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x102040810, 0x202020202020202, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x102040810, 0x202020202020202, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000},
-    {0x4020100804020100, 0x4020100804020100, 0x404040404040404, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x4020100804020100, 0x4020100804020100, 0x404040404040404, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x4020100804020100, 0x4020100804020100, 0x404040404040404, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0xff000000, 0xff000000, 0x4000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x10204081020, 0x10204081020, 0x404040404040404, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x10204081020, 0x10204081020, 0x404040404040404, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x10204081020, 0x10204081020, 0x404040404040404, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x10204081020, 0x10204081020, 0x404040404040404, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100},
-    {0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x808080808080808, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x808080808080808, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x808080808080808, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0xff000000, 0xff000000, 0xff000000, 0x8000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x808080808080808, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x808080808080808, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x808080808080808, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x808080808080808, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201},
-    {0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x1010101010101010, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x1010101010101010, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x1010101010101010, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x10000000, 0xff000000, 0xff000000, 0xff000000, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x1010101010101010, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x1010101010101010, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x1010101010101010, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x1010101010101010, 0x80402010080402, 0x80402010080402, 0x80402010080402},
-    {0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x2020202020202020, 0x204081020408000, 0x204081020408000, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x2020202020202020, 0x204081020408000, 0x204081020408000, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x2020202020202020, 0x204081020408000, 0x204081020408000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x20000000, 0xff000000, 0xff000000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x2020202020202020, 0x804020100804, 0x804020100804, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x2020202020202020, 0x804020100804, 0x804020100804, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x2020202020202020, 0x804020100804, 0x804020100804, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x2020202020202020, 0x804020100804, 0x804020100804},
-    {0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x4040404040404040, 0x408102040800000, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x4040404040404040, 0x408102040800000, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x4040404040404040, 0x408102040800000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x40000000, 0xff000000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x4040404040404040, 0x8040201008, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x4040404040404040, 0x8040201008, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x4040404040404040, 0x8040201008, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x4040404040404040, 0x8040201008},
-    {0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x8080808080808080, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x8080808080808080, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x80402010, 0x8080808080808080, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x80000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x8080808080808080, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x8080808080808080, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x8080808080808080, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x8080808080808080},
-    {0x101010101010101, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x101010101010101, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x101010101010101, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x101010101010101, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x102040810, 0x100000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0x101010101010101, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x101010101010101, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x101010101010101, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000},
-    {0x1008040201000000, 0x202020202020202, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x1008040201000000, 0x202020202020202, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x1008040201000000, 0x202020202020202, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x1008040201000000, 0x202020202020202, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0xff00000000, 0x200000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0x10204081020, 0x202020202020202, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x10204081020, 0x202020202020202, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x10204081020, 0x202020202020202, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000},
-    {0x2010080402010000, 0x2010080402010000, 0x404040404040404, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x2010080402010000, 0x2010080402010000, 0x404040404040404, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x2010080402010000, 0x2010080402010000, 0x404040404040404, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x2010080402010000, 0x2010080402010000, 0x404040404040404, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0xff00000000, 0xff00000000, 0x400000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0x1020408102040, 0x1020408102040, 0x404040404040404, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x1020408102040, 0x1020408102040, 0x404040404040404, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x1020408102040, 0x1020408102040, 0x404040404040404, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000},
-    {0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x808080808080808, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x808080808080808, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x808080808080808, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x808080808080808, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0xff00000000, 0xff00000000, 0xff00000000, 0x800000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x808080808080808, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x808080808080808, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x808080808080808, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100},
-    {0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x1010101010101010, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x1010101010101010, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x1010101010101010, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x1010101010101010, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0x1000000000, 0xff00000000, 0xff00000000, 0xff00000000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x1010101010101010, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x1010101010101010, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x1010101010101010, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201},
-    {0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x2020202020202020, 0x408102040800000, 0x408102040800000, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x2020202020202020, 0x408102040800000, 0x408102040800000, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x2020202020202020, 0x408102040800000, 0x408102040800000, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x2020202020202020, 0x408102040800000, 0x408102040800000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0x2000000000, 0xff00000000, 0xff00000000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x2020202020202020, 0x80402010080402, 0x80402010080402, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x2020202020202020, 0x80402010080402, 0x80402010080402, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x2020202020202020, 0x80402010080402, 0x80402010080402},
-    {0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x4040404040404040, 0x810204080000000, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x4040404040404040, 0x810204080000000, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x4040404040404040, 0x810204080000000, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x4040404040404040, 0x810204080000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0x4000000000, 0xff00000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x4040404040404040, 0x804020100804, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x4040404040404040, 0x804020100804, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x4040404040404040, 0x804020100804},
-    {0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8080808080808080, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8080808080808080, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8080808080808080, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8040201008, 0x8080808080808080, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0xff00000000, 0x8000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x8080808080808080, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x8080808080808080, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x8080808080808080},
-    {0x101010101010101, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x101010101010101, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x101010101010101, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x101010101010101, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x101010101010101, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10204081020, 0x10000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0x101010101010101, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x101010101010101, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000},
-    {0x804020100000000, 0x202020202020202, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x804020100000000, 0x202020202020202, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x804020100000000, 0x202020202020202, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x804020100000000, 0x202020202020202, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x804020100000000, 0x202020202020202, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0xff0000000000, 0x20000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0x1020408102040, 0x202020202020202, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x1020408102040, 0x202020202020202, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000},
-    {0x1008040201000000, 0x1008040201000000, 0x404040404040404, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x1008040201000000, 0x1008040201000000, 0x404040404040404, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x1008040201000000, 0x1008040201000000, 0x404040404040404, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x1008040201000000, 0x1008040201000000, 0x404040404040404, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x1008040201000000, 0x1008040201000000, 0x404040404040404, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0xff0000000000, 0xff0000000000, 0x40000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0x102040810204080, 0x102040810204080, 0x404040404040404, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x102040810204080, 0x102040810204080, 0x404040404040404, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000},
-    {0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x808080808080808, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x808080808080808, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x808080808080808, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x808080808080808, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x808080808080808, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0x80000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x808080808080808, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x808080808080808, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000},
-    {0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x1010101010101010, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x1010101010101010, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x1010101010101010, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x1010101010101010, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x1010101010101010, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0x100000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x1010101010101010, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x1010101010101010, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100},
-    {0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x2020202020202020, 0x810204080000000, 0x810204080000000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x2020202020202020, 0x810204080000000, 0x810204080000000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x2020202020202020, 0x810204080000000, 0x810204080000000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x2020202020202020, 0x810204080000000, 0x810204080000000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x2020202020202020, 0x810204080000000, 0x810204080000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0x200000000000, 0xff0000000000, 0xff0000000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x2020202020202020, 0x8040201008040201, 0x8040201008040201, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x2020202020202020, 0x8040201008040201, 0x8040201008040201},
-    {0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x4040404040404040, 0x1020408000000000, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x4040404040404040, 0x1020408000000000, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x4040404040404040, 0x1020408000000000, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x4040404040404040, 0x1020408000000000, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x4040404040404040, 0x1020408000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0x400000000000, 0xff0000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x4040404040404040, 0x80402010080402, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x4040404040404040, 0x80402010080402},
-    {0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x8080808080808080, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x8080808080808080, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x8080808080808080, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x8080808080808080, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x804020100804, 0x8080808080808080, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0xff0000000000, 0x800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x8080808080808080, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x8080808080808080},
-    {0x101010101010101, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x101010101010101, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x101010101010101, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x101010101010101, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x101010101010101, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x101010101010101, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1020408102040, 0x1000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0x101010101010101, 0x201000000000000, 0x201000000000000, 0x201000000000000, 0x201000000000000, 0x201000000000000, 0x201000000000000, 0x201000000000000},
-    {0x402010000000000, 0x202020202020202, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x402010000000000, 0x202020202020202, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x402010000000000, 0x202020202020202, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x402010000000000, 0x202020202020202, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x402010000000000, 0x202020202020202, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x402010000000000, 0x202020202020202, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0xff000000000000, 0x2000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0x102040810204080, 0x202020202020202, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000, 0x402010000000000},
-    {0x804020100000000, 0x804020100000000, 0x404040404040404, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x804020100000000, 0x804020100000000, 0x404040404040404, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x804020100000000, 0x804020100000000, 0x404040404040404, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x804020100000000, 0x804020100000000, 0x404040404040404, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x804020100000000, 0x804020100000000, 0x404040404040404, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x804020100000000, 0x804020100000000, 0x404040404040404, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0xff000000000000, 0xff000000000000, 0x4000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0x204081020408000, 0x204081020408000, 0x404040404040404, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x804020100000000},
-    {0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x808080808080808, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x808080808080808, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x808080808080808, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x808080808080808, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x808080808080808, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x808080808080808, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0x8000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x808080808080808, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000},
-    {0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x1010101010101010, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x1010101010101010, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x1010101010101010, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x1010101010101010, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x1010101010101010, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x1010101010101010, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0x10000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x1010101010101010, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000},
-    {0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x2020202020202020, 0x1020408000000000, 0x1020408000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x2020202020202020, 0x1020408000000000, 0x1020408000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x2020202020202020, 0x1020408000000000, 0x1020408000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x2020202020202020, 0x1020408000000000, 0x1020408000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x2020202020202020, 0x1020408000000000, 0x1020408000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x2020202020202020, 0x1020408000000000, 0x1020408000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0x20000000000000, 0xff000000000000, 0xff000000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x2020202020202020, 0x4020100804020100, 0x4020100804020100},
-    {0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x4040404040404040, 0x2040800000000000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x4040404040404040, 0x2040800000000000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x4040404040404040, 0x2040800000000000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x4040404040404040, 0x2040800000000000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x4040404040404040, 0x2040800000000000, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x4040404040404040, 0x2040800000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0x40000000000000, 0xff000000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x2040800000000000, 0x4040404040404040, 0x8040201008040201},
-    {0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x8080808080808080, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x8080808080808080, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x8080808080808080, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x8080808080808080, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x8080808080808080, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x80402010080402, 0x8080808080808080, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0xff000000000000, 0x80000000000000, 0x4080000000000000, 0x4080000000000000, 0x4080000000000000, 0x4080000000000000, 0x4080000000000000, 0x4080000000000000, 0x4080000000000000, 0x8080808080808080},
-    {0x101010101010101, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x101010101010101, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x101010101010101, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x101010101010101, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x101010101010101, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x101010101010101, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x101010101010101, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x102040810204080, 0x100000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000},
-    {0x201000000000000, 0x202020202020202, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x201000000000000, 0x202020202020202, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x201000000000000, 0x202020202020202, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x201000000000000, 0x202020202020202, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x201000000000000, 0x202020202020202, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x201000000000000, 0x202020202020202, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x201000000000000, 0x202020202020202, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0x204081020408000, 0xff00000000000000, 0x200000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000},
-    {0x402010000000000, 0x402010000000000, 0x404040404040404, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x402010000000000, 0x402010000000000, 0x404040404040404, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x402010000000000, 0x402010000000000, 0x404040404040404, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x402010000000000, 0x402010000000000, 0x404040404040404, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x402010000000000, 0x402010000000000, 0x404040404040404, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x402010000000000, 0x402010000000000, 0x404040404040404, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x402010000000000, 0x402010000000000, 0x404040404040404, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0x408102040800000, 0xff00000000000000, 0xff00000000000000, 0x400000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000},
-    {0x804020100000000, 0x804020100000000, 0x804020100000000, 0x808080808080808, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x808080808080808, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x808080808080808, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x808080808080808, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x808080808080808, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x808080808080808, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x804020100000000, 0x804020100000000, 0x804020100000000, 0x808080808080808, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0x810204080000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0x800000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000},
-    {0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1010101010101010, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1010101010101010, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1010101010101010, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1010101010101010, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1010101010101010, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1010101010101010, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1008040201000000, 0x1010101010101010, 0x1020408000000000, 0x1020408000000000, 0x1020408000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0x1000000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000},
-    {0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2020202020202020, 0x2040800000000000, 0x2040800000000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2020202020202020, 0x2040800000000000, 0x2040800000000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2020202020202020, 0x2040800000000000, 0x2040800000000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2020202020202020, 0x2040800000000000, 0x2040800000000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2020202020202020, 0x2040800000000000, 0x2040800000000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2020202020202020, 0x2040800000000000, 0x2040800000000000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2010080402010000, 0x2020202020202020, 0x2040800000000000, 0x2040800000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0x2000000000000000, 0xff00000000000000, 0xff00000000000000},
-    {0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4040404040404040, 0x4080000000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4040404040404040, 0x4080000000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4040404040404040, 0x4080000000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4040404040404040, 0x4080000000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4040404040404040, 0x4080000000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4040404040404040, 0x4080000000000000, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4020100804020100, 0x4040404040404040, 0x4080000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0x4000000000000000, 0xff00000000000000},
-    {0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8080808080808080, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8080808080808080, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8080808080808080, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8080808080808080, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8080808080808080, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8080808080808080, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8040201008040201, 0x8080808080808080, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0xff00000000000000, 0x8000000000000000}
-};
-
-// This is the code I used to pre-compute the ColinearMask
-/*
-#include <array>
-std::array<uint64_t, 64> populateColinearMask(uint8_t squareA) {
-    std::array<uint64_t, 64> result= {};
-
-    for (uint8_t squareB = 0; squareB < 64; squareB++) {
-        int fileA = squareA % 8;
-        int rankA = squareA / 8;
-        int fileB = squareB % 8;
-        int rankB = squareB / 8;
-
-        // Calculate delta
-        int deltaFile = fileB - fileA;
-        int deltaRank = rankB - rankA;
-
-        // Determine direction
-        int dirFile = (deltaFile != 0) ? (deltaFile > 0 ? 1 : -1) : 0;
-        int dirRank = (deltaRank != 0) ? (deltaRank > 0 ? 1 : -1) : 0;
-
-        // Iterate through the range from -8 to 7
-        for (int i = -8; i < 8; ++i) {
-            // Calculate the new coordinate (file, rank)
-            int newFile = fileA + dirFile * i;
-            int newRank = rankA + dirRank * i;
-
-            bool isValidSquare = (newFile >= 0 && newFile < 8 && newRank >= 0 && newRank < 8);
-            if (isValidSquare) {
-                // If valid, set the bit in the alignMask for squareA and squareB
-                result[squareB] |= (1ULL << (newRank * 8 + newFile));
-            }
+inline constexpr std::array<uint64_t, 64> BMasks = GBishopMasks();
+
+// The full line through a that heads towards b. Squares that don't share a line with a still get the line
+// in b's general direction, but we only ever look up aligned squares (pinned piece & its king).
+constexpr uint64_t GColinear(int a, int b) {
+    if (a == b) {
+        return 1ULL << a;
+    }
+
+    int dRank = b / 8 - a / 8;
+    int dFile = b % 8 - a % 8;
+
+    int stepRank = (dRank > 0) - (dRank < 0);
+    int stepFile = (dFile > 0) - (dFile < 0);
+
+    return (1ULL << a) | GRay(a, stepRank, stepFile, false) | GRay(a, -stepRank, -stepFile, false);
+}
+
+// Indexed [from][to]. At 32KB it matters that this is inline, so every translation unit shares one copy.
+constexpr std::array<std::array<uint64_t, 64>, 64> GColinearMask() {
+    std::array<std::array<uint64_t, 64>, 64> masks {};
+    for (int a = 0; a < 64; a++) {
+        for (int b = 0; b < 64; b++) {
+            masks[a][b] = GColinear(a, b);
         }
     }
+    return masks;
+}
+
+inline constexpr std::array<std::array<uint64_t, 64>, 64> ColinearMask = GColinearMask();
 
-    return result;
+// The squares strictly between a and b, or nothing if they don't share a rank, file or diagonal.
+constexpr uint64_t GBetween(int a, int b) {
+    int dRank = b / 8 - a / 8;
+    int dFile = b % 8 - a % 8;
+
+    bool aligned = (dRank == 0) != (dFile == 0) || (dRank != 0 && (dRank == dFile || dRank == -dFile));
+    if (!aligned) {
+        return 0;
+    }
+
+    int stepRank = (dRank > 0) - (dRank < 0);
+    int stepFile = (dFile > 0) - (dFile < 0);
+
+    // everything from a towards b, minus everything from b onwards.
+    return GRay(a, stepRank, stepFile, false) & ~(GRay(b, stepRank, stepFile, false) | (1ULL << b));
 }
 
-void writeColinearMap() {
-    std::ofstream outfile("ColinearMask.dat");
-    outfile << "const uint64_t ColinearMask[64][64] = {\n";
-    for (int i = 0; i < 64; i++) {
-        outfile << "    {";
-        std::array<uint64_t, 64> ithmask = populateColinearMask(i);
-        for (int j = 0; j < 64; j++) {
-            outfile << "0x" << std::hex << ithmask[j];
-            if (j != 63) outfile << ", ";  // Add a comma after each element except the last one
+// Indexed [from][to], same layout as ColinearMask.
+constexpr std::array<std::array<uint64_t, 64>, 64> GBetweenMask() {
+    std::array<std::array<uint64_t, 64>, 64> masks {};
+    for (int a = 0; a < 64; a++) {
+        for (int b = 0; b < 64; b++) {
+            masks[a][b] = GBetween(a, b);
         }
-        outfile << "}";
-        if (i != 63) outfile << ",";  // Add a comma after each row except the last one
-        outfile << "\n";
     }
+    return masks;
+}
 
-    outfile << "};\n";
-}*/
+inline constexpr std::array<std::array<uint64_t, 64>, 64> BetweenMask = GBetweenMask();
 
 #endif // ATTACK_MASKS_H
@@ -1,5 +1,14 @@
 #pragma once
 
+// Piece values. Kings are priceless, this just has to outweigh everything else put together.
+// chess_tune can regenerate this whole file from a set of labelled positions.
+const int pawnValue   = 100;
+const int knightValue = 200;
+const int bishopValue = 230;
+const int rookValue   = 400;
+const int queenValue  = 900;
+const int kingValue   = 2000;
+
 // Early-Game Piece Square Tables (HCE) for every piece (from Chess Programming Wiki)
 // https://www.chessprogramming.org/Simplified_Evaluation_Function
 const int pawnTable[64] = {
@@ -1,52 +1,11 @@
-#include "MagicBitboards.h"
-#include "BitFunctions.h"
-
-// Attack lookup tables
-static uint64_t* RAttacks[64];
-static uint64_t* BAttacks[64];
-
-// Size of attack tables for each square
-static const int RAttackSize[64] = {
-    4096, 2048, 2048, 2048, 2048, 2048, 2048, 4096,
-    2048, 1024, 1024, 1024, 1024, 1024, 1024, 2048,
-    2048, 1024, 1024, 1024, 1024, 1024, 1024, 2048,
-    2048, 1024, 1024, 1024, 1024, 1024, 1024, 2048,
-    2048, 1024, 1024, 1024, 1024, 1024, 1024, 2048,
-    2048, 1024, 1024, 1024, 1024, 1024, 1024, 2048,
-    2048, 1024, 1024, 1024, 1024, 1024, 1024, 2048,
-    4096, 2048, 2048, 2048, 2048, 2048, 2048, 4096
-};
+#include <array>
 
-static const int BAttackSize[64] = {
-    64, 32, 32, 32, 32, 32, 32, 64,
-    32, 32, 32, 32, 32, 32, 32, 32,
-    32, 32, 128, 128, 128, 128, 32, 32,
-    32, 32, 128, 512, 512, 128, 32, 32,
-    32, 32, 128, 512, 512, 128, 32, 32,
-    32, 32, 128, 128, 128, 128, 32, 32,
-    32, 32, 32, 32, 32, 32, 32, 32,
-    64, 32, 32, 32, 32, 32, 32, 64
-};
+#include "MagicBitboards.h"
 
 // Helper functions
-#pragma warning(push)
-#pragma warning(disable : 4146)
-static inline uint64_t indexToUint64(int index, int bits, uint64_t m) {
-    uint64_t result = 0ULL;
-    for (int i = 0; i < bits; i++) {
-        uint64_t least_bit = m & -m;
-        if (index & (1 << i)) {
-            result |= least_bit;
-        }
-        m &= (m - 1);
-    }
-    return result;
-}
-#pragma warning(pop)
-
-static uint64_t ratt(int sq, uint64_t block) {
+static constexpr uint64_t ratt(int sq, uint64_t block) {
     uint64_t result = 0ULL;
-    int rk = sq / 8, fl = sq % 8, r, f;
+    int rk = sq / 8, fl = sq % 8, r = 0, f = 0;
 
     for (r = rk + 1; r <= 7; r++) {
         result |= (1ULL << (fl + r * 8));
@@ -67,9 +26,9 @@ static uint64_t ratt(int sq, uint64_t block) {
     return result;
 }
 
-static uint64_t batt(int sq, uint64_t block) {
+static constexpr uint64_t batt(int sq, uint64_t block) {
     uint64_t result = 0ULL;
-    int rk = sq / 8, fl = sq % 8, r, f;
+    int rk = sq / 8, fl = sq % 8, r = 0, f = 0;
 
     for (r = rk + 1, f = fl + 1; r <= 7 && f <= 7; r++, f++) {
         result |= (1ULL << (f + r * 8));
@@ -90,56 +49,65 @@ static uint64_t batt(int sq, uint64_t block) {
     return result;
 }
 
-// Public interface implementations
-uint64_t getRookAttacks(int square, uint64_t occupied) {
-    occupied &= RMasks[square];
-    occupied *= RMagic[square];
-    occupied >>= RShifts[square];
-    return RAttacks[square][occupied];
+static constexpr std::array<SMagic, 64> GMagics(const std::array<uint64_t, 64>& masks, const uint64_t (&magics)[64],
+                                                const int (&shifts)[64], uint32_t offset) {
+    std::array<SMagic, 64> table {};
+    for (int square = 0; square < 64; square++) {
+        table[square] = { masks[square], magics[square], offset, (uint32_t)shifts[square] };
+        offset += 1U << (64 - shifts[square]);
+    }
+    return table;
 }
 
-uint64_t getBishopAttacks(int square, uint64_t occupied) {
-    occupied &= BMasks[square];
-    occupied *= BMagic[square];
-    occupied >>= BShifts[square];
-    return BAttacks[square][occupied];
+static constexpr int GBitCount(uint64_t bits) {
+    int count = 0;
+    for (; bits; bits &= bits - 1) count++;
+    return count;
 }
 
-uint64_t getQueenAttacks(int square, uint64_t occupied) {
-    return getRookAttacks(square, occupied) | getBishopAttacks(square, occupied);
+// PEXT indexes a slice with popcount(mask) bits and reuses the magic layout as-is, so the two have to agree.
+static constexpr bool GShiftsMatchMasks(const std::array<SMagic, 64>& magics) {
+    for (const SMagic& m : magics) {
+        if (m.shift != (uint32_t)(64 - GBitCount(m.mask))) return false;
+    }
+    return true;
 }
 
-void initMagicBitboards(void) {
-    for (int square = 0; square < 64; square++) {
-        // Initialize rook attacks
-        RAttacks[square] = new uint64_t[RAttackSize[square]];
-        uint64_t mask = RMasks[square];
-        int bits = popCount(mask);
-        int n = 1 << bits;
-
-        for (int i = 0; i < n; i++) {
-            uint64_t subset = indexToUint64(i, bits, mask);
-            uint64_t index = (subset * RMagic[square]) >> RShifts[square];
-            RAttacks[square][index] = ratt(square, subset);
-        }
+constexpr std::array<SMagic, 64> RookMagics   = GMagics(RMasks, RMagic, RShifts, 0);
+constexpr std::array<SMagic, 64> BishopMagics = GMagics(BMasks, BMagic, BShifts, RTableSize);
 
-        // Initialize bishop attacks
-        BAttacks[square] = new uint64_t[BAttackSize[square]];
-        mask = BMasks[square];
-        bits = popCount(mask);
-        n = 1 << bits;
+#ifdef CHESS_USE_PEXT
+static_assert(GShiftsMatchMasks(RookMagics) && GShiftsMatchMasks(BishopMagics), "PEXT needs 64 - shift == popcount(mask) on every square");
+#endif
 
-        for (int i = 0; i < n; i++) {
-            uint64_t subset = indexToUint64(i, bits, mask);
-            uint64_t index = (subset * BMagic[square]) >> BShifts[square];
-            BAttacks[square][index] = batt(square, subset);
-        }
+static constexpr void GFillSlices(std::array<uint64_t, RTableSize + BTableSize>& table, const std::array<SMagic, 64>& magics,
+                                  uint64_t (*attacks)(int, uint64_t)) {
+    for (int square = 0; square < 64; square++) {
+        const SMagic& m = magics[square];
+        // Carry-Rippler, walks every subset of the mask without having to build each one from an index.
+        // https://www.chessprogramming.org/Traversing_Subsets_of_a_Set
+        // It also happens to walk them in increasing order, which is the same order PEXT numbers them in.
+        uint64_t subset = 0;
+#ifdef CHESS_USE_PEXT
+        uint32_t index = 0;
+#endif
+        do {
+#ifdef CHESS_USE_PEXT
+            table[m.offset + index++] = attacks(square, subset);
+#else
+            table[m.offset + ((subset * m.magic) >> m.shift)] = attacks(square, subset);
+#endif
+            subset = (subset - m.mask) & m.mask;
+        } while (subset);
     }
 }
 
-void cleanupMagicBitboards(void) {
-    for (int square = 0; square < 64; square++) {
-        delete[] RAttacks[square];
-        delete[] BAttacks[square];
-    }
+static constexpr std::array<uint64_t, RTableSize + BTableSize> GSliderAttacks() {
+    std::array<uint64_t, RTableSize + BTableSize> table {};
+    GFillSlices(table, RookMagics, ratt);
+    GFillSlices(table, BishopMagics, batt);
+    return table;
 }
+
+// One contiguous attack table for both sliders (~840KB), generated at compile time.
+alignas(64) constexpr std::array<uint64_t, RTableSize + BTableSize> SliderAttacks = GSliderAttacks();
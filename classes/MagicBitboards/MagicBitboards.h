@@ -4,10 +4,11 @@
 #define MAGIC_BITBOARDS_H
 
 #include <stdint.h>
+#include <array>
 
-// Function declarations
-void initMagicBitboards(void);
-void cleanupMagicBitboards(void);
+#ifdef CHESS_USE_PEXT
+#include <immintrin.h>
+#endif
 
 // Bitboard manipulation macros
 #define SET_BIT(bb, sq) ((bb) |= (1ULL << (sq)))
@@ -34,9 +35,56 @@ void cleanupMagicBitboards(void);
 #include "AttackMasks.h" // Contains RMasks[], BMasks[]
 #include "PieceAttacks.h" // Contains KnightAttacks[], KingAttacks[], PawnAttacks[][]
 
+// Everything a lookup needs for one square, packed together. Aligned so a square never straddles cache lines,
+// which means a lookup touches one line of metadata & one line of the attack table.
+struct alignas(32) SMagic {
+    uint64_t mask;
+    uint64_t magic;
+    uint32_t offset; // where this square's slice starts in SliderAttacks
+    uint32_t shift;
+};
+
+// Rook slices come first, then bishops. A slice holds 2^(64 - shift) entries, the number of indices its magic can produce.
+constexpr uint32_t GTableSize(const int (&shifts)[64]) {
+    uint32_t size = 0;
+    for (int square = 0; square < 64; square++) {
+        size += 1U << (64 - shifts[square]);
+    }
+    return size;
+}
+
+inline constexpr uint32_t RTableSize = GTableSize(RShifts);
+inline constexpr uint32_t BTableSize = GTableSize(BShifts);
+
+// Generated at compile time in MagicBitboards.cpp. Only declared here so the lookups below can be inlined
+// into the move generator without every translation unit having to evaluate the tables.
+extern const std::array<SMagic, 64> RookMagics;
+extern const std::array<SMagic, 64> BishopMagics;
+extern const std::array<uint64_t, RTableSize + BTableSize> SliderAttacks;
+
+// BMI2 hardware does the gather for us, but PEXT is microcoded (and slow) on AMD before Zen 3,
+// so it stays opt in with CHESS_USE_PEXT and the magic multiply is the default.
+inline uint32_t sliceIndex(const SMagic& m, const uint64_t occupied) {
+#ifdef CHESS_USE_PEXT
+    return (uint32_t)_pext_u64(occupied, m.mask);
+#else
+    return (uint32_t)(((occupied & m.mask) * m.magic) >> m.shift);
+#endif
+}
+
 // Attack lookup functions
-uint64_t getRookAttacks(int square, uint64_t occupied);
-uint64_t getBishopAttacks(int square, uint64_t occupied);
-uint64_t getQueenAttacks(int square, uint64_t occupied);
+inline uint64_t getRookAttacks(int square, uint64_t occupied) {
+    const SMagic& m = RookMagics[square];
+    return SliderAttacks[m.offset + sliceIndex(m, occupied)];
+}
+
+inline uint64_t getBishopAttacks(int square, uint64_t occupied) {
+    const SMagic& m = BishopMagics[square];
+    return SliderAttacks[m.offset + sliceIndex(m, occupied)];
+}
+
+inline uint64_t getQueenAttacks(int square, uint64_t occupied) {
+    return getRookAttacks(square, occupied) | getBishopAttacks(square, occupied);
+}
 
 #endif // MAGIC_BITBOARDS_H
@@ -4,7 +4,7 @@
 #include <stdint.h>
 
 // Magic numbers for rooks
-const uint64_t RMagic[64] = {
+constexpr uint64_t RMagic[64] = {
     0xa8002c000108020ULL, 0x6c00049b0002001ULL, 0x100200010090040ULL, 0x2480041000800801ULL,
     0x280028004000800ULL, 0x900410008040022ULL, 0x280020001001080ULL, 0x2880002041000080ULL,
     0xa000800080400034ULL, 0x4808020004000ULL, 0x2290802004801000ULL, 0x411000d00100020ULL,
@@ -24,7 +24,7 @@ const uint64_t RMagic[64] = {
 };
 
 // Magic numbers for bishops
-const uint64_t BMagic[64] = {
+constexpr uint64_t BMagic[64] = {
     0x89a1121896040240ULL, 0x2004844802002010ULL, 0x2068080051921000ULL, 0x62880a0220200808ULL,
     0x4042004000000ULL, 0x100822020200011ULL, 0xc00444222012000aULL, 0x28808801216001ULL,
     0x400492088408100ULL, 0x201c401040c0084ULL, 0x840800910a0010ULL, 0x82080240060ULL,
@@ -44,7 +44,7 @@ const uint64_t BMagic[64] = {
 };
 
 // Magic bitboard shift amounts
-const int RShifts[64] = {
+constexpr int RShifts[64] = {
     52, 53, 53, 53, 53, 53, 53, 52,
     53, 54, 54, 54, 54, 54, 54, 53,
     53, 54, 54, 54, 54, 54, 54, 53,
@@ -55,7 +55,7 @@ const int RShifts[64] = {
     52, 53, 53, 53, 53, 53, 53, 52
 };
 
-const int BShifts[64] = {
+constexpr int BShifts[64] = {
     58, 59, 59, 59, 59, 59, 59, 58,
     59, 59, 59, 59, 59, 59, 59, 59,
     59, 59, 57, 57, 57, 57, 59, 59,
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapped file. Used for anything big we'd rather have the OS page in for us
+// (position databases, training data) instead of reading the whole thing into the heap.
+class MappedFile {
+	public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	// returns false if the file doesn't exist, is empty, or can't be mapped.
+	bool open(const std::string& path);
+	void close();
+
+	bool isOpen() const { return _data != nullptr; }
+	const uint8_t* data() const { return _data; }
+	size_t size() const { return _size; }
+
+	private:
+	const uint8_t* _data = nullptr;
+	size_t _size = 0;
+#ifdef _WIN32
+	void* _mapping = nullptr;
+#endif
+};
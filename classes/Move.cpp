@@ -38,4 +38,20 @@ void Move::setFlagBits(uint8_t flag) {
 
 void Move::toggleFlags(uint8_t flag) {
 	move = ((move & ~0xfff) ^ (flag << 12)) | (move & 0xfff);
-}
\ No newline at end of file
+}
+
+std::string Move::toUCI() const {
+	const uint8_t from = getFrom();
+	const uint8_t to = getTo();
+	std::string name = {
+		(char)('a' + (from & 7)), (char)('1' + (from >> 3)),
+		(char)('a' + (to & 7)),   (char)('1' + (to >> 3))
+	};
+
+	const uint8_t flags = getFlags();
+	if (flags & ToQueen)  name += 'q';
+	if (flags & ToKnight) name += 'n';
+	if (flags & ToRook)   name += 'r';
+	if (flags & ToBishop) name += 'b';
+	return name;
+}
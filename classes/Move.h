@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <string>
 
 // I'm ultimately conflicted on what size I should store my moves as.
 // Since I'm not aiming to do bitboards for this leg of the project (maybe get to in the future?)
@@ -60,6 +61,9 @@ class Move {
 	bool QueenSideCastle()	const { return (getFlags() &  FlagCodes::QCastle)		!= 0; }
 	bool isCastle()			const { return (getFlags() &  FlagCodes::Castling)      != 0; }
 
+	// long algebraic / UCI style name, ex. "e2e4" or "e7e8q".
+	std::string toUCI() const;
+
 	// Future proofing
 	uint16_t getButterflyIndex() const { return move & 0x0fff; }
 
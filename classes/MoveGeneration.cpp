@@ -3,27 +3,24 @@
 #include "MagicBitboards/MagicBitboards.h"
 #include "MagicBitboards/BitFunctions.h"
 
-#include "PrecomputedData.h"
-
 #ifdef DEBUG
 #include "../tools/Logger.h"
 #endif
 
 // TODO: Change MoveTable to be a vector.
 
-bool inCheck;
-bool pinned;
-bool doubleCheck;
-bool pinInPosition;
-uint8_t friendlyKingSquare;
-uint64_t checkRayBitmask;
-uint64_t pinRayBitmask;
-uint64_t attackMap;
-const int dir[8] = {8, 1, -8, -1, 9, -7, -9, 7};
-bool generateQuiets;
+// scratch state for the position currently being generated. thread_local so separate searchers
+// (ex. chess_epd's worker threads) can each generate moves without stepping on each other.
+thread_local bool inCheck;
+thread_local bool pinned;
+thread_local bool doubleCheck;
+thread_local bool pinInPosition;
+thread_local uint8_t friendlyKingSquare;
+thread_local uint64_t checkRayBitmask;
+thread_local uint64_t pinRayBitmask;
+thread_local bool generateQuiets;
 
 inline void ReInitGen() {
-	attackMap = 0ULL;
 	inCheck = false;
 	pinned = false;
 	doubleCheck = false;
@@ -44,23 +41,44 @@ std::vector<Move> Chess::MoveGenerator(GameState& state, bool capturesOnly) {
 	// reset variables.
 	ReInitGen();
 	friendlyKingSquare = state.getFriendlyKingSquare();
-	CalculateAttackData(state);
+
+	// the only place we branch on colour, everything below is instantiated per side.
+	if (state.isBlackTurn()) {
+		GenerateMoves<Color::Black>(list, state);
+	} else {
+		GenerateMoves<Color::White>(list, state);
+	}
+
+	return list;
+}
+
+template<Color Us>
+void Chess::GenerateMoves(std::vector<Move>& list, GameState& state) {
+	CalculateAttackData<Us>(state);
 
 #ifdef DEBUG
 	//Loggy.log("Attack Map - " + std::to_string(attackMap));
 #endif
 
-	GenerateKingMoves(list, state);
+	GenerateKingMoves<Us>(list, state);
 
 	if (doubleCheck) {
-		return list;
+		return;
 	}
 
-	GenerateSlidingMoves(list, state);
-	GenerateKnightMoves(list, state);
-	GeneratePawnMoves(list, state);
+	GenerateSlidingMoves<Us>(list, state);
+	GenerateKnightMoves<Us>(list, state);
+	GeneratePawnMoves<Us>(list, state);
+}
 
-	return list;
+// compile time stand-ins for GameState's friendly/enemy occupancy getters, which check the side to move every call.
+template<Color C>
+static inline uint64_t occupancyOf(const GameState& state) {
+	if constexpr (C == Color::White) {
+		return state.getProtoBoard().getWhiteOccupancyBoard();
+	} else {
+		return state.getProtoBoard().getBlackOccupancyBoard();
+	}
 }
 
 /*
@@ -81,257 +99,207 @@ void Chess::sortMovesByMVVLVA(ProtoBoard& board, std::vector<Move>& captureMoves
 }
 */
 
-inline int getDirectionOffset(int a, int b) {
-    // Convert linear index a and b to (row, col)
-    int row_a = a / 8;
-    int col_a = a % 8;
-    int row_b = b / 8;
-    int col_b = b % 8;
-
-    // Calculate the differences in row and column
-    int delta_row = row_b - row_a;
-    int delta_col = col_b - col_a;
-
-	// These numbers are the directions the index's of _dist and dir represent. 
-	const int NORTH = 0;
-	const int EAST = 1;
-	const int SOUTH = 2;
-	const int WEST = 3;
-	const int NORTH_EAST = 4;
-	const int SOUTH_EAST = 5;
-	const int SOUTH_WEST = 6;
-	const int NORTH_WEST = 7;
-
-    if (delta_col == 0) {
-		return delta_row > 0 ? NORTH : SOUTH;
-	}
-
-	if (delta_row == 0) {
-		return delta_col > 0 ? EAST : WEST;
-	}
-
-	if (delta_col > 0) {
-		return delta_row > 0 ? NORTH_EAST : SOUTH_EAST;
-	}
-	else {
-		return delta_row > 0 ? NORTH_WEST : SOUTH_WEST;
-	}
+// Reverse attack lookup: put each piece type on the square & see if it hits an enemy piece of that type.
+// Much cheaper than building everything the enemy attacks when we only care about a couple of squares.
+template<Color Them>
+static inline bool squareAttackedBy(const GameState& state, const uint8_t square, const uint64_t occupancy) {
+	constexpr bool black = Them == Color::Black;
+	const uint64_t queens = state.getPieceOccupancyBoard(ChessPiece::Queen, black);
+
+	return (PawnAttacks[square][!black] & state.getPieceOccupancyBoard(ChessPiece::Pawn,   black))
+	    || (KnightAttacks[square]        & state.getPieceOccupancyBoard(ChessPiece::Knight, black))
+	    || (KingAttacks[square]          & state.getPieceOccupancyBoard(ChessPiece::King,   black))
+	    || (getBishopAttacks(square, occupancy) & (state.getPieceOccupancyBoard(ChessPiece::Bishop, black) | queens))
+	    || (getRookAttacks(square, occupancy)   & (state.getPieceOccupancyBoard(ChessPiece::Rook,   black) | queens));
 }
 
-void Chess::CalculateAttackData(GameState& state) {
-	bool blackIsEnemy = !state.isBlackTurn();
-	// update sliding attack lanes
-	uint64_t occupancy = state.getOccupancyBoard();
-	uint64_t sliderBoard;
-	// index of King Square on bitboard.
-	const uint64_t kingBit = 1ULL << friendlyKingSquare;
-
-	{
-		uint64_t blockers = occupancy ^ kingBit;
-		uint64_t rooks = state.getPieceOccupancyBoard(ChessPiece::Rook, blackIsEnemy);
-		sliderBoard |= rooks;
-		forEachBit([&](uint8_t square) {
-			attackMap |= getRookAttacks(square, blockers);
-		}, rooks);
-
-		uint64_t bishops = state.getPieceOccupancyBoard(ChessPiece::Bishop, blackIsEnemy);
-		sliderBoard |= bishops;
-		forEachBit([&](uint8_t square) {
-			attackMap |= getBishopAttacks(square, blockers);
-		}, bishops);
-
-		uint64_t queens = state.getPieceOccupancyBoard(ChessPiece::Queen, blackIsEnemy);
-		sliderBoard |= queens;
-		forEachBit([&](uint8_t square) {
-			attackMap |= getQueenAttacks(square, blockers);
-		}, queens);
-	}
-#ifdef DEBUG
-	//Loggy.log(Logger::WARNING, "Sliding Step - " + std::to_string(attackMap));
-#endif
+bool Chess::isSquareAttacked(const GameState& state, const uint8_t square, const uint64_t occupancy) {
+	return state.isBlackTurn() ? squareAttackedBy<Color::White>(state, square, occupancy)
+	                           : squareAttackedBy<Color::Black>(state, square, occupancy);
+}
 
-	// we keep track of sliderBoards b/c bitboards don't include the piece's starting square
-	// keeping track of this is relatively cheap & most of the time still saves time over just brute force
-	// checking every direction.
-	uint64_t kingAdjacentDanger = KingAttacks[friendlyKingSquare] & (attackMap | sliderBoard);
-	uint64_t friendly = state.getFriendlyOccuupancyBoard();
+uint64_t Chess::AttackMap(const GameState& state, const bool byBlack) {
+	const uint64_t occupancy = state.getOccupancyBoard();
+	const uint64_t queens    = state.getPieceOccupancyBoard(ChessPiece::Queen, byBlack);
+	const uint64_t pawns     = state.getPieceOccupancyBoard(ChessPiece::Pawn,  byBlack);
 
-	// check around king for pins
+	uint64_t attacks = byBlack ? BLACK_PAWN_ATTACKS(pawns) : WHITE_PAWN_ATTACKS(pawns);
 	forEachBit([&](uint8_t square) {
-		// we don't need to search any more if we're already in doubleCheck.
-		// This is up here b/c I can't break out of the bits method in a single statement, so program
-		// control would return to top and go through whole loop again.
-		if (doubleCheck) {
-			return;
-		}
+		attacks |= getRookAttacks(square, occupancy);
+	}, state.getPieceOccupancyBoard(ChessPiece::Rook, byBlack) | queens);
+	forEachBit([&](uint8_t square) {
+		attacks |= getBishopAttacks(square, occupancy);
+	}, state.getPieceOccupancyBoard(ChessPiece::Bishop, byBlack) | queens);
+	forEachBit([&](uint8_t square) {
+		attacks |= KnightAttacks[square];
+	}, state.getPieceOccupancyBoard(ChessPiece::Knight, byBlack));
+	forEachBit([&](uint8_t square) {
+		attacks |= KingAttacks[square];
+	}, state.getPieceOccupancyBoard(ChessPiece::King, byBlack));
 
-		int direction = getDirectionOffset(friendlyKingSquare, square);
-		int n = _dist[friendlyKingSquare][direction];
-		int dirOffset = dir[direction];
-		bool friendlyBlock = false;
-		uint64_t rayMask = 0;
-		bool onDiagonal = direction > 3;
-
-		for (int i = 0; i < n; i++) {
-			uint8_t currSquare = friendlyKingSquare + (dirOffset * (i + 1));
-			rayMask |= 1ULL << currSquare;
-
-			ChessPiece piece = state.PieceFromIndex(currSquare);
-			if (piece == NoPiece) continue;
-
-			bool friendlyPiece = (friendly & (1ULL << currSquare)) != 0;
-			if (friendlyPiece) {
-				if (!friendlyBlock) {
-					friendlyBlock = true;
-					continue;
-				}
-
-				break;
-			}
-
-			// Enemy piece here
-			if ((onDiagonal && IsDiagonalPiece(piece)) || (!onDiagonal && IsHorizontalPiece(piece))) {
-				// Friendly piece blocks, so it is pinned
-				if (friendlyBlock) {
-					pinInPosition = true;
-					pinRayBitmask |= rayMask;
-				} else {
-					// no block, so we're in check.
-					checkRayBitmask |= rayMask;
-					doubleCheck = inCheck;
-					inCheck = true;
-				}
-				break;
-			} else {
-				break;
-				// piece cannot attack king, blocking any potential pins/checks
-			}
+	return attacks;
+}
+
+template<Color Us>
+void Chess::CalculateAttackData(GameState& state) {
+	constexpr bool blackIsEnemy = Us == Color::White;
+	const uint64_t occupancy = state.getOccupancyBoard();
+	const uint64_t friendly  = occupancyOf<Us>(state);
+	const uint64_t enemies   = occupancyOf<~Us>(state);
+
+	const uint64_t queens    = state.getPieceOccupancyBoard(ChessPiece::Queen,  blackIsEnemy);
+	const uint64_t cardinals = state.getPieceOccupancyBoard(ChessPiece::Rook,   blackIsEnemy) | queens;
+	const uint64_t ordinals  = state.getPieceOccupancyBoard(ChessPiece::Bishop, blackIsEnemy) | queens;
+	const uint64_t knights   = state.getPieceOccupancyBoard(ChessPiece::Knight, blackIsEnemy);
+	const uint64_t pawns     = state.getPieceOccupancyBoard(ChessPiece::Pawn,   blackIsEnemy);
+
+	// Checkers: look outwards from the king as each piece type, whatever we hit of that type is giving check.
+	// Pawns work the same way, a pawn of ours on the king square would attack exactly the squares enemy pawns check from.
+	const uint64_t checkers = (getRookAttacks(friendlyKingSquare, occupancy)   & cardinals)
+	                        | (getBishopAttacks(friendlyKingSquare, occupancy) & ordinals)
+	                        | (KnightAttacks[friendlyKingSquare] & knights)
+	                        | (PawnAttacks[friendlyKingSquare][Us == Color::Black] & pawns);
+
+	if (checkers) {
+		inCheck = true;
+		doubleCheck = (checkers & (checkers - 1)) != 0;
+		// with one checker, a move has to take it or land between it & the king (empty for knights & pawns).
+		if (!doubleCheck) {
+			const uint8_t checker = bitScanForward(checkers);
+			checkRayBitmask = BetweenMask[friendlyKingSquare][checker] | checkers;
 		}
+	}
 
-	// Since attackMap currently only has sliding data, any piece adjacent to the king that's in danger
-	// is likely to threaten the king. So we filter out rays that are obviously safe.
-	}, kingAdjacentDanger);
+	// Pins: x-ray from the king through our own pieces. Any slider that shows up with exactly one piece (ours, since
+	// only enemies block the x-ray) between it & the king is pinning that piece.
+	const uint64_t snipers = (getRookAttacks(friendlyKingSquare, enemies)   & cardinals)
+	                       | (getBishopAttacks(friendlyKingSquare, enemies) & ordinals);
+	forEachBit([&](uint8_t sniper) {
+		const uint64_t between = BetweenMask[friendlyKingSquare][sniper];
+		const uint64_t blockers = between & occupancy;
+		if (blockers && (blockers & (blockers - 1)) == 0 && (blockers & friendly)) {
+			pinInPosition = true;
+			pinRayBitmask |= between | (1ULL << sniper);
+		}
+	}, snipers);
 
-	uint8_t enemyKingSquare = state.getEnemyKingSquare();
+#ifdef DEBUG
+	//Loggy.log(Logger::WARNING, "Check Ray - " + std::to_string(checkRayBitmask));
+	//Loggy.log(Logger::WARNING, "Pin Ray   - " + std::to_string(pinRayBitmask));
+#endif
+}
 
-	// king attacks
-	attackMap |= KingAttacks[enemyKingSquare];
+// Pawns are done set-wise: shift every pawn at once, mask the targets, then walk the targets and work out where
+// each one came from with a fixed offset. Pushes/captures for each direction are just a couple of bitboard ops.
+template<Color Us>
+static inline uint64_t pawnPush(const uint64_t pawns) {
+	if constexpr (Us == Color::White) return NORTH(pawns); else return SOUTH(pawns);
+}
 
-	// Knight Attacks
-	uint64_t knights = state.getPieceOccupancyBoard(ChessPiece::Knight, blackIsEnemy);
-	bool isKnightCheck = false;
-	uint64_t knightAttackMap = 0;
-	forEachBit([&](uint8_t fromSquare) {
-		uint64_t attacks = KnightAttacks[fromSquare];
-		knightAttackMap |= attacks;
-		// if knight is attacking king, update doubleCheck status.
-		if (!isKnightCheck && ((knightAttackMap & kingBit) != 0)) {
-			isKnightCheck = true;
-			doubleCheck = inCheck;
-			inCheck = true;
-			checkRayBitmask |= 1ULL << fromSquare;
-		}
-	}, knights);
+// captures towards the a-file & h-file respectively, named from white's point of view.
+template<Color Us>
+static inline uint64_t pawnAttackWest(const uint64_t pawns) {
+	if constexpr (Us == Color::White) return NORTH_WEST(pawns); else return SOUTH_WEST(pawns);
+}
 
-	attackMap |= knightAttackMap;
+template<Color Us>
+static inline uint64_t pawnAttackEast(const uint64_t pawns) {
+	if constexpr (Us == Color::White) return NORTH_EAST(pawns); else return SOUTH_EAST(pawns);
+}
 
-	// Pawn Attacks
-	uint64_t pawns = state.getPieceOccupancyBoard(ChessPiece::Pawn, blackIsEnemy);
-	bool pawnCheck = false;
-	uint64_t pawnAttackMap = 0;
-	forEachBit([&](uint8_t fromSquare) {
-		uint64_t attacks = PawnAttacks[fromSquare][blackIsEnemy];
-		pawnAttackMap |= attacks;
-
-		if (!pawnCheck && (pawnAttackMap & kingBit) != 0) {
-			pawnCheck = true;
-			doubleCheck = inCheck;
-			inCheck = true;
-			checkRayBitmask |= (1ULL << fromSquare);
-		}
-	}, pawns);
+// from = to - offset for each of the shifts above.
+template<Color Us> constexpr int pushOffset = Us == Color::White ?  8 : -8;
+template<Color Us> constexpr int westOffset = Us == Color::White ?  7 : -9;
+template<Color Us> constexpr int eastOffset = Us == Color::White ?  9 : -7;
 
-	attackMap |= pawnAttackMap;
+// where a pawn lands to promote, and where a single push has to land for a double push to be possible.
+template<Color Us> constexpr uint64_t promotionRankMask = Us == Color::White ? 0xFF00000000000000ULL : 0x00000000000000FFULL;
+template<Color Us> constexpr uint64_t doublePushRankMask = Us == Color::White ? 0x0000000000FF0000ULL : 0x0000FF0000000000ULL;
 
-	// TODO: saving king, pawn, knight into attack map not neccesary,
-	// TODO: 
+static inline void emitPawnMoves(std::vector<Move>& moves, const uint64_t targets, const int offset, const uint8_t flags = 0) {
+	forEachBit([&](uint8_t toSquare) {
+		moves.emplace_back(toSquare - offset, toSquare, flags);
+	}, targets);
+}
 
-	// TODO: add check to attack map for potential checks after enpassant
+static inline void emitPromotions(std::vector<Move>& moves, const uint64_t targets, const int offset) {
+	forEachBit([&](uint8_t toSquare) {
+		for (int i = 0; i < 4; i++) {
+			moves.emplace_back(toSquare - offset, toSquare, Move::FlagCodes::ToQueen << i);
+		}
+	}, targets);
+}
 
-#ifdef DEBUG
-	//Loggy.log(Logger::WARNING, "Pawn Step - " + std::to_string(attackMap));
-	//Loggy.log(Logger::WARNING, "Check Ray - " + std::to_string(checkRayBitmask));
-	//Loggy.log(Logger::WARNING, "Pin Ray   - " + std::to_string(pinRayBitmask));
-#endif
+template<Color Us>
+inline void Chess::GeneratePawnTargets(std::vector<Move>& moves, const uint64_t pawns, const uint64_t empty, const uint64_t enemies, const uint64_t targetMask) {
+	constexpr uint64_t promoRank = promotionRankMask<Us>;
+
+	const uint64_t singles = pawnPush<Us>(pawns) & empty;
+	const uint64_t doubles = pawnPush<Us>(singles & doublePushRankMask<Us>) & empty & targetMask;
+	const uint64_t pushes  = singles & targetMask;
+	const uint64_t west    = pawnAttackWest<Us>(pawns) & enemies & targetMask;
+	const uint64_t east    = pawnAttackEast<Us>(pawns) & enemies & targetMask;
+
+	emitPawnMoves(moves, pushes & ~promoRank, pushOffset<Us>);
+	emitPawnMoves(moves, doubles, 2 * pushOffset<Us>, Move::FlagCodes::DoublePush);
+	emitPawnMoves(moves, west & ~promoRank, westOffset<Us>);
+	emitPawnMoves(moves, east & ~promoRank, eastOffset<Us>);
+
+	if ((pushes | west | east) & promoRank) {
+		emitPromotions(moves, pushes & promoRank, pushOffset<Us>);
+		emitPromotions(moves, west & promoRank, westOffset<Us>);
+		emitPromotions(moves, east & promoRank, eastOffset<Us>);
+	}
 }
 
+template<Color Us>
 void Chess::GeneratePawnMoves(std::vector<Move>& moves, GameState& state) {
-	uint64_t pawns = state.getPieceOccupancyBoard(ChessPiece::Pawn, state.isBlackTurn());
+	constexpr bool black = Us == Color::Black;
+	const uint64_t pawns     = state.getPieceOccupancyBoard(ChessPiece::Pawn, black);
 	const uint64_t occupancy = state.getOccupancyBoard();
-	const uint64_t enemies   = state.getEnemyOccuupancyBoard();
+	const uint64_t enemies   = occupancyOf<~Us>(state);
+	const uint64_t empty     = ~occupancy;
+
+	// when in check, every move has to land on the check ray (block it or take the checker).
+	const uint64_t checkMask = inCheck ? checkRayBitmask : ~0ULL;
+	const uint64_t pinned    = pinInPosition ? (pawns & pinRayBitmask) : 0ULL;
 
+	GeneratePawnTargets<Us>(moves, pawns & ~pinned, empty, enemies, checkMask);
+
+	// pins are rare enough that the pinned pawns can go one at a time, each only allowed to stay on its pin ray.
 	forEachBit([&](uint8_t fromSquare) {
-		GeneratePawnPush(moves, state, occupancy, fromSquare);
-		GeneratePawnAttack(moves, state, enemies, fromSquare);
-	}, pawns);
-}
+		GeneratePawnTargets<Us>(moves, 1ULL << fromSquare, empty, enemies, checkMask & ColinearMask[fromSquare][friendlyKingSquare]);
+	}, pinned);
 
-inline void Chess::GeneratePawnPush(std::vector<Move>& moves, GameState& state, const uint64_t occupancy, const uint8_t fromSquare) {
-	int moveDir = state.isBlackTurn() ? dir[2] : dir[0];
-	uint8_t toSquare = fromSquare + moveDir;
-	
-	if ((occupancy & (1ULL << toSquare)) == 0) {
-		// Make sure that we continue to block if pushing. 
-		if (inCheck && !squareIsInCheckRay(toSquare)) return;
-
-		bool canPromote = toSquare == (state.isBlackTurn() ? (fromSquare % 8) : (fromSquare % 8) + 56);
-		if (canPromote) {
-			for (int i = 0; i < 4; i++) {
-				moves.emplace_back(fromSquare, toSquare, Move::FlagCodes::ToQueen << i);
-			}
-		} else {
-			moves.emplace_back(fromSquare, toSquare);
-			bool canDPush = state.isBlackTurn() ? ((fromSquare / 8) == BlackPawnStartRank) : ((fromSquare / 8) == WhitePawnStartRank);
-			if (!canDPush) return;
-
-			toSquare += moveDir;
-			// there is for sure a cleaner way of doing this, but for the moment we run this check twice so
-			// we don't get a situation where we can make this move, even though it doesn't block check.
-			if (inCheck && !squareIsInCheckRay(toSquare)) return;
-			if (canDPush && ((occupancy & (1ULL << toSquare)) == 0)) {
-				moves.emplace_back(fromSquare, toSquare, Move::FlagCodes::DoublePush);
-			}
-		}
-	}
-}
+	// en passant. Rare too, and the captured pawn leaving can expose the king sideways (which pin detection can't see
+	// since two pieces leave the rank), so just check the position after the capture directly.
+	const uint8_t epSquare = state.getEnPassantSquare();
+	if (epSquare >= 64) return;
 
-inline void Chess::GeneratePawnAttack(std::vector<Move>& moves, GameState& state, const uint64_t enemies, const uint8_t fromSquare) {
-	uint64_t attacks = PawnAttacks[fromSquare][state.isBlackTurn()] & enemies;
-	//& checkRayBitmask;
-	forEachBit([&](uint8_t toSquare) {
-		if (inCheck && !squareIsInCheckRay(toSquare)) return;
-
-		bool EnPassant = state.getEnPassantSquare() == toSquare;
-		// if enpassant square is specified, then we know it's a legal move b/c en passant square is set on previous turn.
-
-		// promote captures combos
-		bool canPromote = toSquare == (state.isBlackTurn() ? (toSquare % 8) : (toSquare % 8) + 56);
-		if (canPromote) {
-			for (int i = 0; i < 4; i++) {
-				moves.emplace_back(fromSquare, toSquare, Move::FlagCodes::ToQueen << i);
-			}
-		} else {
-			moves.emplace_back(fromSquare, toSquare, EnPassant ? Move::FlagCodes::EnCapture : 0);
-		}
-	}, attacks);
+	const uint64_t epBit       = 1ULL << epSquare;
+	const uint64_t capturedBit = 1ULL << (epSquare - pushOffset<Us>);
+	// the captured pawn might be the checker, in which case the capture resolves check even if we don't land on the ray.
+	if (inCheck && (checkRayBitmask & (epBit | capturedBit)) == 0) return;
+
+	const uint64_t enemyCardinals = state.getPieceOccupancyBoard(ChessPiece::Rook,   !black) | state.getPieceOccupancyBoard(ChessPiece::Queen, !black);
+	const uint64_t enemyOrdinals  = state.getPieceOccupancyBoard(ChessPiece::Bishop, !black) | state.getPieceOccupancyBoard(ChessPiece::Queen, !black);
+
+	// reverse lookup: the pawns that can capture onto the ep square are the ones an enemy pawn there would attack.
+	forEachBit([&](uint8_t fromSquare) {
+		const uint64_t after = (occupancy ^ (1ULL << fromSquare) ^ capturedBit) | epBit;
+		if (getRookAttacks(friendlyKingSquare, after) & enemyCardinals) return;
+		if (getBishopAttacks(friendlyKingSquare, after) & enemyOrdinals) return;
+		moves.emplace_back(fromSquare, epSquare, Move::FlagCodes::EnCapture);
+	}, PawnAttacks[epSquare][!black] & pawns);
 }
 
+template<Color Us>
 void Chess::GenerateKnightMoves(std::vector<Move>& moves, GameState& state) {
 	// all non-pinned knights
-	uint64_t knights = state.getPieceOccupancyBoard(ChessPiece::Knight, state.isBlackTurn()) & ~pinRayBitmask;
-	const uint64_t friends   = state.getFriendlyOccuupancyBoard();
-	const uint64_t moveMask  = ~friends;
-	//& checkRayBitmask;
+	uint64_t knights = state.getPieceOccupancyBoard(ChessPiece::Knight, Us == Color::Black) & ~pinRayBitmask;
+	const uint64_t friends   = occupancyOf<Us>(state);
+	// in check a knight can only block or capture the checker, which is exactly the check ray.
+	const uint64_t moveMask  = ~friends & (inCheck ? checkRayBitmask : ~0ULL);
 
 	forEachBit([&](uint8_t fromSquare) {
 		if (inCheck && isPinned(fromSquare)) return;
@@ -339,21 +307,18 @@ void Chess::GenerateKnightMoves(std::vector<Move>& moves, GameState& state) {
 		uint64_t attacks = KnightAttacks[fromSquare] & moveMask;
 		moves.reserve(popCount(attacks));
 		forEachBit([&](uint8_t toSquare) {
-			// if generating only captures, or this is not a blocking move while in check, break.
-			if ((inCheck && !squareIsInCheckRay(toSquare))) return;
-			// skip if in check & knight is not going to block/capture attacking piece
 			moves.emplace_back(fromSquare, toSquare);
 		}, attacks);
 	}, knights);
 }
 
-#include <functional>
-
 // TODO: consider merging sliding moves down to simplify things. Queen doesn't need her own step.
+template<Color Us>
 void Chess::GenerateSlidingMoves(std::vector<Move>& moves, GameState& state) {
-	const uint64_t queens    = state.getPieceOccupancyBoard(ChessPiece::Queen,  state.isBlackTurn());
-	uint64_t cardinals 		 = state.getPieceOccupancyBoard(ChessPiece::Rook,   state.isBlackTurn()) | queens;
-	uint64_t ordinals 		 = state.getPieceOccupancyBoard(ChessPiece::Bishop, state.isBlackTurn()) | queens;
+	constexpr bool black = Us == Color::Black;
+	const uint64_t queens    = state.getPieceOccupancyBoard(ChessPiece::Queen,  black);
+	uint64_t cardinals 		 = state.getPieceOccupancyBoard(ChessPiece::Rook,   black) | queens;
+	uint64_t ordinals 		 = state.getPieceOccupancyBoard(ChessPiece::Bishop, black) | queens;
 
 	if (inCheck) {
 		cardinals &= ~pinRayBitmask;
@@ -361,19 +326,34 @@ void Chess::GenerateSlidingMoves(std::vector<Move>& moves, GameState& state) {
 	}
 
 	const uint64_t occupancy = state.getOccupancyBoard();
-	const uint64_t enemies   = state.getEnemyOccuupancyBoard();
+	const uint64_t enemies   = occupancyOf<~Us>(state);
 
 	// TODO: optimisation can be made here if we are only interested in non-quiet moves
 	const uint64_t moveMask  = (~occupancy | enemies);
 	//& checkRayBitmask;
 
-	GenerateSlidingMovesHelper(moves, getRookAttacks,  cardinals, occupancy, enemies, moveMask);
-	GenerateSlidingMovesHelper(moves, getBishopAttacks, ordinals, occupancy, enemies, moveMask);
+	// queens are already folded into both sets, so they go down the rook & bishop paths.
+	GenerateSlidingMovesHelper<ChessPiece::Rook>(moves,   cardinals, occupancy, moveMask);
+	GenerateSlidingMovesHelper<ChessPiece::Bishop>(moves, ordinals,  occupancy, moveMask);
+}
+
+// Resolved at compile time so the table lookup gets inlined into the loop below, this is the hottest part of movegen.
+template<ChessPiece Slider>
+static inline uint64_t slidingAttacks(const uint8_t square, const uint64_t occupancy) {
+	static_assert(Slider == ChessPiece::Rook || Slider == ChessPiece::Bishop || Slider == ChessPiece::Queen, "not a sliding piece");
+	if constexpr (Slider == ChessPiece::Rook) {
+		return getRookAttacks(square, occupancy);
+	} else if constexpr (Slider == ChessPiece::Bishop) {
+		return getBishopAttacks(square, occupancy);
+	} else {
+		return getQueenAttacks(square, occupancy);
+	}
 }
 
-void Chess::GenerateSlidingMovesHelper(std::vector<Move>& moves, const std::function<uint64_t(uint8_t, uint64_t)>& getAttacksFunc, const uint64_t& pieceMap, const uint64_t& occupancy, const uint64_t& enemies, const uint64_t& moveMask) {
+template<ChessPiece Slider>
+void Chess::GenerateSlidingMovesHelper(std::vector<Move>& moves, const uint64_t pieceMap, const uint64_t occupancy, const uint64_t moveMask) {
 	forEachBit([&](uint8_t fromSquare) {
-		uint64_t attacks = getAttacksFunc(fromSquare, occupancy) & moveMask;
+		uint64_t attacks = slidingAttacks<Slider>(fromSquare, occupancy) & moveMask;
 
 		// If pinned, we can only move along that ray.
 		if (isPinned(fromSquare)) {
@@ -391,53 +371,40 @@ void Chess::GenerateSlidingMovesHelper(std::vector<Move>& moves, const std::func
 	}, pieceMap);
 }
 
+template<Color Us>
 void Chess::GenerateKingMoves(std::vector<Move>& moves, GameState& state) {
-	bool black = state.isBlackTurn();
-	const uint64_t enemies   = state.getEnemyOccuupancyBoard();
-	const uint64_t friends   = state.getFriendlyOccuupancyBoard();
-	const uint64_t attacks   = KingAttacks[friendlyKingSquare] & ~(attackMap | friends);
+	constexpr bool black = Us == Color::Black;
+	const uint64_t friends   = occupancyOf<Us>(state);
+	const uint64_t occupancy = state.getOccupancyBoard();
+	// take the king off the board while testing, otherwise he'd shadow squares behind him from a checking slider.
+	const uint64_t kingless  = occupancy ^ (1ULL << friendlyKingSquare);
 
 	forEachBit([&](uint8_t toSquare) {
-		bool capture = (enemies & (1ULL << toSquare));
-
-		// If this is not a capture...
-		if (!capture) {
-			// Can't go to dangerous square unless is capturing that piece
-			// TODO: skip if not generating quiet moves
-			if(squareIsInCheckRay(toSquare)) {
-				return;
-			}
-		}
-
-		// This space is safe for the king to move to
-		if (!(attackMap & (1ULL << toSquare))) {
+		if (!squareAttackedBy<~Us>(state, toSquare, kingless)) {
 			moves.emplace_back(friendlyKingSquare, toSquare);
 		}
-	}, attacks);
-
-	bool canCastleKingSide  = (state.getCastlingRights() & (black ? 0b0010 : 0b1000)) != 0;
-	bool canCastleQueenSide = (state.getCastlingRights() & (black ? 0b0001 : 0b0100)) != 0;
+	}, KingAttacks[friendlyKingSquare] & ~friends);
 
 	// castling
-	if (!inCheck && generateQuiets) {
-		const uint64_t occupancy = state.getOccupancyBoard();
-		// KingSide, f1, f8
-		const uint64_t blockers = attackMap | occupancy;
-		if (canCastleKingSide) {
-			const uint64_t mask = state.isBlackTurn() ? PositionMasks::BlackKingsideMask : PositionMasks::WhiteKingsideMask;
-			if ((mask & blockers) == 0) {
-				const uint8_t castleSquare = friendlyKingSquare + 2;
-				moves.emplace_back(friendlyKingSquare, castleSquare, Move::FlagCodes::KCastle);
-			}
+	if (inCheck || !generateQuiets) return;
+
+	const uint8_t rights = state.getCastlingRights();
+	// KingSide, f1 & g1 have to be empty and safe.
+	if (rights & (black ? 0b0010 : 0b1000)) {
+		constexpr uint64_t mask = black ? PositionMasks::BlackKingsideMask : PositionMasks::WhiteKingsideMask;
+		if ((mask & occupancy) == 0
+			&& !squareAttackedBy<~Us>(state, friendlyKingSquare + 1, occupancy)
+			&& !squareAttackedBy<~Us>(state, friendlyKingSquare + 2, occupancy)) {
+			moves.emplace_back(friendlyKingSquare, friendlyKingSquare + 2, Move::FlagCodes::KCastle);
 		}
-		// QueenSide, d1, d8
-		if (canCastleQueenSide) {
-			const uint64_t mask      = state.isBlackTurn() ? PositionMasks::BlackQueensideMask      : PositionMasks::WhiteQueensideMask;
-			//const uint64_t blockMask = state.isBlackTurn() ? PositionMasks::BlackQueensideBlockMask : PositionMasks::WhiteQueensideBlockMask;
-			if (((mask & blockers) == 0)) {
-				const uint8_t castleSquare = friendlyKingSquare - 2;
-				moves.emplace_back(friendlyKingSquare, castleSquare, Move::FlagCodes::QCastle);
-			}
+	}
+	// QueenSide, b1 c1 d1 have to be empty, but the king never crosses b1 so only c1 & d1 have to be safe.
+	if (rights & (black ? 0b0001 : 0b0100)) {
+		constexpr uint64_t blockMask = black ? PositionMasks::BlackQueensideBlockMask : PositionMasks::WhiteQueensideBlockMask;
+		if ((blockMask & occupancy) == 0
+			&& !squareAttackedBy<~Us>(state, friendlyKingSquare - 1, occupancy)
+			&& !squareAttackedBy<~Us>(state, friendlyKingSquare - 2, occupancy)) {
+			moves.emplace_back(friendlyKingSquare, friendlyKingSquare - 2, Move::FlagCodes::QCastle);
 		}
 	}
 }
@@ -445,13 +412,3 @@ void Chess::GenerateKingMoves(std::vector<Move>& moves, GameState& state) {
 bool Chess::isPinned(int index) {
 	return pinInPosition && ((pinRayBitmask >> index) & 1) != 0;
 }
-
-bool Chess::isMovingAlongRay(int asile, int startSquare, int targetSquare) {
-	int moveDir = dir[targetSquare - startSquare + 63];
-	return (asile == moveDir || -asile == moveDir);
-}
-
-// TODO: with clever use of checkRayBitmask this funciton is entierly uneeded.
-bool Chess::squareIsInCheckRay(int square) {
-	return inCheck && ((checkRayBitmask >> square) & 1) != 0;
-}
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+#include "NNUE.h"
+#include "MagicBitboards/BitFunctions.h"
+
+namespace NNUE {
+	bool loaded = false;
+
+	// Network file: this header, then every array below in order, little endian (host order, like PackedPosition).
+	struct Header {
+		char magic[8];
+		uint32_t inputs;
+		uint32_t hidden;
+		uint32_t reserved[4];
+	};
+	static const char MAGIC[8] = {'C', 'H', 'E', 'S', 'S', 'N', 'N', '1'};
+
+	// The network is trained in floats against a sigmoid of eval / OUTPUT_SCALE, then quantised:
+	// hidden weights by HIDDEN_QUANT, output weights by OUTPUT_QUANT.
+	const int HIDDEN_QUANT = 127;
+	const int OUTPUT_QUANT = 64;
+	const int OUTPUT_SCALE = 400;
+
+	alignas(64) static int16_t hiddenBias[HIDDEN];
+	alignas(64) static int16_t hiddenWeights[INPUTS * HIDDEN]; // one column of HIDDEN per input
+	alignas(64) static int8_t outputWeights[2 * HIDDEN];       // side to move's half first
+	static int32_t outputBias;
+
+	bool load(const std::string& path) {
+		std::ifstream in(path, std::ios::binary);
+		if (!in) return false;
+
+		Header header;
+		in.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!in || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.inputs != INPUTS || header.hidden != HIDDEN) {
+			return false;
+		}
+
+		// read everything into scratch first, so a truncated file can't leave us with half a network.
+		std::vector<char> data(sizeof(hiddenBias) + sizeof(hiddenWeights) + sizeof(outputWeights) + sizeof(outputBias));
+		in.read(data.data(), data.size());
+		if (!in) return false;
+
+		const char* p = data.data();
+		std::memcpy(hiddenBias, p, sizeof(hiddenBias));
+		p += sizeof(hiddenBias);
+		std::memcpy(hiddenWeights, p, sizeof(hiddenWeights));
+		p += sizeof(hiddenWeights);
+		std::memcpy(outputWeights, p, sizeof(outputWeights));
+		p += sizeof(outputWeights);
+		std::memcpy(&outputBias, p, sizeof(outputBias));
+
+		loaded = true;
+		return true;
+	}
+
+	// Input index of a piece on a square, seen from one side. Black's view is flipped so both sides look the same.
+	// index is the ProtoBoard index of the piece (kings excluded), which already separates colours.
+	static inline int inputIndex(const int view, const int kingSquare, const int index, const int square) {
+		const int flip = view ? 56 : 0;
+		const bool theirs = (index >= 6) != (view == 1);
+		const int piece = (index % 6) * 2 + theirs;
+		return (kingSquare ^ flip) * 640 + piece * 64 + (square ^ flip);
+	}
+
+	// accumulator += column / -= column. HIDDEN is a multiple of every vector width, and everything's 64 byte aligned.
+	static inline void addColumn(int16_t* values, const int16_t* column) {
+#if defined(__AVX2__)
+		for (int i = 0; i < HIDDEN; i += 16) {
+			__m256i* v = reinterpret_cast<__m256i*>(values + i);
+			*v = _mm256_add_epi16(*v, *reinterpret_cast<const __m256i*>(column + i));
+		}
+#elif defined(__SSSE3__)
+		for (int i = 0; i < HIDDEN; i += 8) {
+			__m128i* v = reinterpret_cast<__m128i*>(values + i);
+			*v = _mm_add_epi16(*v, *reinterpret_cast<const __m128i*>(column + i));
+		}
+#else
+		for (int i = 0; i < HIDDEN; i++) {
+			values[i] += column[i];
+		}
+#endif
+	}
+
+	static inline void subColumn(int16_t* values, const int16_t* column) {
+#if defined(__AVX2__)
+		for (int i = 0; i < HIDDEN; i += 16) {
+			__m256i* v = reinterpret_cast<__m256i*>(values + i);
+			*v = _mm256_sub_epi16(*v, *reinterpret_cast<const __m256i*>(column + i));
+		}
+#elif defined(__SSSE3__)
+		for (int i = 0; i < HIDDEN; i += 8) {
+			__m128i* v = reinterpret_cast<__m128i*>(values + i);
+			*v = _mm_sub_epi16(*v, *reinterpret_cast<const __m128i*>(column + i));
+		}
+#else
+		for (int i = 0; i < HIDDEN; i++) {
+			values[i] -= column[i];
+		}
+#endif
+	}
+
+	static void refreshView(Accumulator& accumulator, const ProtoBoard& board, const int view) {
+		int16_t* values = accumulator.values[view];
+		std::memcpy(values, hiddenBias, sizeof(hiddenBias));
+
+		const int kingSquare = bitScanForward(board[view ? 11 : 5]);
+		for (int index = 0; index < 12; index++) {
+			if (index == 5 || index == 11) continue;
+			forEachBit([&](uint8_t square) {
+				addColumn(values, hiddenWeights + inputIndex(view, kingSquare, index, square) * HIDDEN);
+			}, board[index]);
+		}
+	}
+
+	void refresh(Accumulator& accumulator, const GameState& state) {
+		refreshView(accumulator, state.getProtoBoard(), 0);
+		refreshView(accumulator, state.getProtoBoard(), 1);
+	}
+
+	static void updateView(Accumulator& child, const Accumulator& parent, const ProtoBoard& before, const ProtoBoard& after, const int view) {
+		if (before[view ? 11 : 5] != after[view ? 11 : 5]) {
+			refreshView(child, after, view);
+			return;
+		}
+
+		const int kingSquare = bitScanForward(after[view ? 11 : 5]);
+		int16_t* values = child.values[view];
+		std::memcpy(values, parent.values[view], sizeof(child.values[view]));
+		// diffing the bitboards covers captures, promotions, en passant & castling without caring which it was.
+		for (int index = 0; index < 12; index++) {
+			if (index == 5 || index == 11) continue;
+			forEachBit([&](uint8_t square) {
+				subColumn(values, hiddenWeights + inputIndex(view, kingSquare, index, square) * HIDDEN);
+			}, before[index] & ~after[index]);
+			forEachBit([&](uint8_t square) {
+				addColumn(values, hiddenWeights + inputIndex(view, kingSquare, index, square) * HIDDEN);
+			}, after[index] & ~before[index]);
+		}
+	}
+
+	void update(Accumulator& child, const Accumulator& parent, const ProtoBoard& before, const GameState& after) {
+		updateView(child, parent, before, after.getProtoBoard(), 0);
+		updateView(child, parent, before, after.getProtoBoard(), 1);
+	}
+
+	// sum of clamp(values, 0, 127) * weights.
+	static inline int32_t dot(const int16_t* values, const int8_t* weights) {
+#if defined(__AVX2__)
+		const __m256i ceiling = _mm256_set1_epi16(127);
+		const __m256i ones = _mm256_set1_epi16(1);
+		__m256i sum = _mm256_setzero_si256();
+		for (int i = 0; i < HIDDEN; i += 32) {
+			const __m256i a = _mm256_min_epi16(*reinterpret_cast<const __m256i*>(values + i), ceiling);
+			const __m256i b = _mm256_min_epi16(*reinterpret_cast<const __m256i*>(values + i + 16), ceiling);
+			// packus clips the negatives to 0, but works per 128 bit lane, so the quarters need putting back in order.
+			const __m256i clipped = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0b11011000);
+			// at most 2 * 127 * 127 per pair, which fits in the int16 maddubs saturates to.
+			const __m256i products = _mm256_maddubs_epi16(clipped, *reinterpret_cast<const __m256i*>(weights + i));
+			sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+		}
+		__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0b01001110));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0b10110001));
+		return _mm_cvtsi128_si32(half);
+#elif defined(__SSSE3__)
+		const __m128i ceiling = _mm_set1_epi16(127);
+		const __m128i ones = _mm_set1_epi16(1);
+		__m128i sum = _mm_setzero_si128();
+		for (int i = 0; i < HIDDEN; i += 16) {
+			const __m128i a = _mm_min_epi16(*reinterpret_cast<const __m128i*>(values + i), ceiling);
+			const __m128i b = _mm_min_epi16(*reinterpret_cast<const __m128i*>(values + i + 8), ceiling);
+			const __m128i clipped = _mm_packus_epi16(a, b);
+			const __m128i products = _mm_maddubs_epi16(clipped, *reinterpret_cast<const __m128i*>(weights + i));
+			sum = _mm_add_epi32(sum, _mm_madd_epi16(products, ones));
+		}
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0b01001110));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0b10110001));
+		return _mm_cvtsi128_si32(sum);
+#else
+		int32_t sum = 0;
+		for (int i = 0; i < HIDDEN; i++) {
+			const int16_t v = values[i] < 0 ? 0 : (values[i] > 127 ? 127 : values[i]);
+			sum += v * weights[i];
+		}
+		return sum;
+#endif
+	}
+
+	int evaluate(const Accumulator& accumulator, const bool blackToMove) {
+		const int us = blackToMove ? 1 : 0;
+		const int32_t output = dot(accumulator.values[us], outputWeights)
+			+ dot(accumulator.values[us ^ 1], outputWeights + HIDDEN) + outputBias;
+		return (int)((int64_t)output * OUTPUT_SCALE / (HIDDEN_QUANT * OUTPUT_QUANT));
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "GameState.h"
+#include "MagicBitboards/ProtoBoard.h"
+
+// Efficiently updatable neural network evaluation. https://www.chessprogramming.org/NNUE
+// HalfKP inputs: one per (own king square, piece, square) for every piece but the kings, seen from each side's view
+// of the board. Each side gets its own hidden layer ("accumulator"), and both go straight to the output:
+//   40960 -> 256 x 2 -> 1
+// An accumulator is just the sum of the weight columns of its active inputs, so a move only adds & subtracts the
+// few columns that changed. When a king moves, every input on its side changes, so that side is rebuilt instead.
+//
+// Quantised like most small nets: int16 hidden weights, the hidden layer clipped to 0..127 and multiplied with int8
+// output weights. AVX2 or SSSE3 is used when the compiler's allowed to (see CHESS_USE_AVX2), otherwise plain C++.
+namespace NNUE {
+	const int INPUTS = 64 * 10 * 64;
+	const int HIDDEN = 256;
+
+	struct alignas(64) Accumulator {
+		int16_t values[2][HIDDEN]; // white's view, black's view
+	};
+
+	// Loads a network. Returns false if the file is missing or malformed, which leaves the old network (if any) alone.
+	bool load(const std::string& path);
+
+	extern bool loaded;
+	inline bool isLoaded() { return loaded; }
+
+	// Builds both sides of the accumulator from scratch.
+	void refresh(Accumulator& accumulator, const GameState& state);
+	// child = parent plus whatever changed between the boards before & after a move.
+	void update(Accumulator& child, const Accumulator& parent, const ProtoBoard& before, const GameState& after);
+	// Centipawns from the side to move's point of view.
+	int evaluate(const Accumulator& accumulator, const bool blackToMove);
+}
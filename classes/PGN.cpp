@@ -0,0 +1,502 @@
+#include <cctype>
+#include <cstring>
+
+#include "PGN.h"
+#include "Chess.h"
+#include "MagicBitboards/MagicBitboards.h"
+#include "MagicBitboards/PieceAttacks.h"
+#include "MagicBitboards/BitFunctions.h"
+
+namespace PGN {
+	const char* const START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+	static const char* const SEVEN_TAG_ROSTER[7] = { "Event", "Site", "Date", "Round", "White", "Black", "Result" };
+
+	std::string Game::tag(const std::string_view name) const {
+		for (const auto& [key, value] : tags) {
+			if (key == name) return value;
+		}
+		return "";
+	}
+
+	void Game::setTag(const std::string& name, const std::string& value) {
+		for (auto& [key, existing] : tags) {
+			if (key == name) {
+				existing = value;
+				return;
+			}
+		}
+		tags.emplace_back(name, value);
+	}
+
+	void Game::clear() {
+		tags.clear();
+		start = GameState::FromFEN(START_FEN);
+		moves.clear();
+		result.assign(1, '*');
+		error.clear();
+	}
+
+	// ========================== SAN ==========================
+
+	static char pieceLetter(const ChessPiece piece) {
+		switch (piece & 7) {
+			case Knight: return 'N';
+			case Bishop: return 'B';
+			case Rook:   return 'R';
+			case Queen:  return 'Q';
+			case King:   return 'K';
+			default:     return '\0';
+		}
+	}
+
+	static ChessPiece pieceFromLetter(const char letter) {
+		switch (letter) {
+			case 'N': return Knight;
+			case 'B': return Bishop;
+			case 'R': return Rook;
+			case 'Q': return Queen;
+			case 'K': return King;
+			default:  return NoPiece;
+		}
+	}
+
+	static uint8_t promotionFlag(const char letter) {
+		switch (letter) {
+			case 'Q': case 'q': return Move::ToQueen;
+			case 'N': case 'n': return Move::ToKnight;
+			case 'R': case 'r': return Move::ToRook;
+			case 'B': case 'b': return Move::ToBishop;
+			default:            return 0;
+		}
+	}
+
+	static char promotionLetter(const Move& move) {
+		const uint8_t flags = move.getFlags();
+		if (flags & Move::ToKnight) return 'N';
+		if (flags & Move::ToRook)   return 'R';
+		if (flags & Move::ToBishop) return 'B';
+		return 'Q';
+	}
+
+	std::string toSAN(const GameState& state, const Move& move) {
+		// MoveGenerator wants a mutable state, it doesn't actually change it.
+		GameState position = state;
+		const std::vector<Move> legal = Chess::MoveGenerator(position);
+
+		const uint8_t from = move.getFrom();
+		const uint8_t to = move.getTo();
+		const ChessPiece piece = (ChessPiece)(state.PieceFromIndex(from) & 7);
+
+		std::string san;
+		if (move.isCastle()) {
+			san = move.KingSideCastle() ? "O-O" : "O-O-O";
+		} else {
+			const bool capture = state.PieceFromIndex(to) != NoPiece || move.isEnCapture();
+			if (piece == Pawn) {
+				if (capture) san += (char)('a' + (from & 7));
+			} else {
+				san += pieceLetter(piece);
+
+				// only say which piece when another one of the same type could also go there.
+				bool ambiguous = false, sameFile = false, sameRank = false;
+				for (const Move& other : legal) {
+					if (other.getTo() != to || other.getFrom() == from) continue;
+					if ((state.PieceFromIndex(other.getFrom()) & 7) != piece) continue;
+					ambiguous = true;
+					sameFile |= (other.getFrom() & 7) == (from & 7);
+					sameRank |= (other.getFrom() >> 3) == (from >> 3);
+				}
+				if (ambiguous) {
+					if (!sameFile) {
+						san += (char)('a' + (from & 7));
+					} else if (!sameRank) {
+						san += (char)('1' + (from >> 3));
+					} else {
+						san += (char)('a' + (from & 7));
+						san += (char)('1' + (from >> 3));
+					}
+				}
+			}
+
+			if (capture) san += 'x';
+			san += (char)('a' + (to & 7));
+			san += (char)('1' + (to >> 3));
+
+			if (move.isPromotion()) {
+				san += '=';
+				san += promotionLetter(move);
+			}
+		}
+
+		GameState next(state, move);
+		const bool replies = !Chess::MoveGenerator(next).empty();
+		if (Chess::InCheck()) {
+			san += replies ? '+' : '#';
+		}
+		return san;
+	}
+
+	// leaves the mover's king safe.
+	static bool isLegal(const GameState& state, const Move& move) {
+		GameState next(state, move);
+		return !(Chess::AttackMap(next, next.isBlackTurn()) & (1ULL << next.getEnemyKingSquare()));
+	}
+
+	// Squares a piece of this type (owned by the side to move) could be moving to "to" from, ignoring pins.
+	static uint64_t sourcesFor(const GameState& state, const ChessPiece piece, const uint8_t to, const bool capture) {
+		const bool black = state.isBlackTurn();
+		const uint64_t pieces = state.getPieceOccupancyBoard(piece, black);
+		const uint64_t occupancy = state.getOccupancyBoard();
+
+		switch (piece) {
+			case Knight: return KnightAttacks[to] & pieces;
+			case Bishop: return getBishopAttacks(to, occupancy) & pieces;
+			case Rook:   return getRookAttacks(to, occupancy) & pieces;
+			case Queen:  return getQueenAttacks(to, occupancy) & pieces;
+			case King:   return KingAttacks[to] & pieces;
+			default: break;
+		}
+
+		// pawns, looking backwards from the target square.
+		if (capture) {
+			return PawnAttacks[to][black ? 0 : 1] & pieces;
+		}
+		const int back = black ? 8 : -8;
+		const int single = to + back;
+		if (single < 0 || single > 63) return 0;
+		if (pieces & (1ULL << single)) return 1ULL << single;
+
+		const int doubleRank = black ? 4 : 3;
+		if ((to >> 3) == doubleRank && !(occupancy & (1ULL << single))) {
+			return pieces & (1ULL << (single + back));
+		}
+		return 0;
+	}
+
+	bool fromSAN(const GameState& state, std::string_view san, Move& move) {
+		// annotations & check marks don't change which move it is.
+		while (!san.empty() && std::strchr("+#!?", san.back())) {
+			san.remove_suffix(1);
+		}
+		if (san.size() < 2) return false;
+
+		if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+			GameState position = state;
+			const bool kingSide = san.size() == 3;
+			for (const Move& candidate : Chess::MoveGenerator(position)) {
+				if (candidate.isCastle() && candidate.KingSideCastle() == kingSide) {
+					move = candidate;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		ChessPiece piece = pieceFromLetter(san.front());
+		if (piece == NoPiece) {
+			piece = Pawn;
+		} else {
+			san.remove_prefix(1);
+		}
+
+		uint8_t promotion = 0;
+		if (san.size() >= 2 && promotionFlag(san.back()) && (san[san.size() - 2] == '=' || std::isdigit((unsigned char)san[san.size() - 2]))) {
+			promotion = promotionFlag(san.back());
+			san.remove_suffix(san[san.size() - 2] == '=' ? 2 : 1);
+		}
+
+		if (san.size() < 2) return false;
+		const char toFile = san[san.size() - 2];
+		const char toRank = san[san.size() - 1];
+		if (toFile < 'a' || toFile > 'h' || toRank < '1' || toRank > '8') return false;
+		const uint8_t to = (toRank - '1') * 8 + (toFile - 'a');
+		san.remove_suffix(2);
+
+		// whatever's left is disambiguation and/or the capture mark.
+		int fromFile = -1, fromRank = -1;
+		for (const char c : san) {
+			if (c >= 'a' && c <= 'h') {
+				fromFile = c - 'a';
+			} else if (c >= '1' && c <= '8') {
+				fromRank = c - '1';
+			} else if (c != 'x' && c != ':' && c != '-') {
+				return false;
+			}
+		}
+
+		// Running the whole move generator for every ply was most of the cost of reading a PGN, so only the named
+		// piece's moves onto the target square get built, then checked for leaving the king in check.
+		const bool black = state.isBlackTurn();
+		const uint64_t targetBit = 1ULL << to;
+		const uint64_t friendly = black ? state.getProtoBoard().getBlackOccupancyBoard() : state.getProtoBoard().getWhiteOccupancyBoard();
+		if (friendly & targetBit) return false;
+
+		uint8_t flags = 0;
+		const bool pawnCapture = piece == Pawn && fromFile >= 0 && fromFile != (to & 7);
+		if (piece == Pawn) {
+			const bool enemyThere = (state.getOccupancyBoard() & targetBit) != 0;
+			if (pawnCapture && !enemyThere) {
+				if (to != state.getEnPassantSquare()) return false;
+				flags |= Move::EnCapture;
+			} else if (!pawnCapture && enemyThere) {
+				return false;
+			}
+
+			const bool lastRank = (to >> 3) == (black ? 0 : 7);
+			if (lastRank != (promotion != 0)) return false;
+			flags |= promotion;
+		} else if (promotion) {
+			return false;
+		}
+
+		uint64_t sources = sourcesFor(state, piece, to, pawnCapture);
+		if (fromFile >= 0) sources &= 0x0101010101010101ULL << fromFile;
+		if (fromRank >= 0) sources &= 0xFFULL << (fromRank * 8);
+
+		int matches = 0;
+		forEachBit([&](uint8_t from) {
+			uint8_t moveFlags = flags;
+			if (piece == Pawn && (from > to ? from - to : to - from) == 16) {
+				moveFlags |= Move::DoublePush;
+			}
+			const Move candidate(from, to, moveFlags);
+			if (isLegal(state, candidate)) {
+				move = candidate;
+				matches++;
+			}
+		}, sources);
+		return matches == 1;
+	}
+
+	// ========================== Reading ==========================
+
+	int Reader::peek() {
+		if (_pos == _end) {
+			_in.read(_buffer, sizeof(_buffer));
+			_end = (size_t)_in.gcount();
+			_pos = 0;
+			if (_end == 0) return EOF;
+		}
+		return (unsigned char)_buffer[_pos];
+	}
+
+	int Reader::get() {
+		const int c = peek();
+		if (c != EOF) _pos++;
+		return c;
+	}
+
+	void Reader::skipWhitespace() {
+		while (true) {
+			const int c = peek();
+			if (c == EOF || !std::isspace(c)) return;
+			_pos++;
+		}
+	}
+
+	void Reader::skipLine() {
+		int c;
+		while ((c = get()) != EOF && c != '\n') {}
+	}
+
+	// { ... }, these don't nest.
+	void Reader::skipComment() {
+		int c;
+		while ((c = get()) != EOF && c != '}') {}
+	}
+
+	// ( ... ), these do nest, and can have comments (which can have brackets) inside them.
+	void Reader::skipVariation() {
+		int depth = 1;
+		int c;
+		while (depth > 0 && (c = get()) != EOF) {
+			if (c == '(') depth++;
+			else if (c == ')') depth--;
+			else if (c == '{') skipComment();
+			else if (c == ';') skipLine();
+		}
+	}
+
+	void Reader::readTag(Game& game) {
+		std::string name;
+		int c;
+		skipWhitespace();
+		while ((c = peek()) != EOF && !std::isspace(c) && c != '"' && c != ']') {
+			name += (char)get();
+		}
+
+		skipWhitespace();
+		std::string value;
+		if (peek() == '"') {
+			get();
+			while ((c = get()) != EOF && c != '"') {
+				if (c == '\\') c = get();
+				if (c == EOF || c == '\n') break;
+				value += (char)c;
+			}
+		}
+		while ((c = get()) != EOF && c != ']' && c != '\n') {}
+
+		if (name == "FEN") {
+			try {
+				game.start = GameState::FromFEN(value);
+			} catch (const std::exception& e) {
+				game.error = e.what();
+			}
+		}
+		game.tags.emplace_back(std::move(name), std::move(value));
+	}
+
+	void Reader::readSymbol(std::string& symbol) {
+		symbol.clear();
+		int c;
+		while ((c = peek()) != EOF && (std::isalnum(c) || (c && std::strchr("_+#=:-/!?", c)))) {
+			symbol += (char)c;
+			_pos++;
+		}
+	}
+
+	static bool isResult(const std::string& symbol) {
+		return symbol == "1-0" || symbol == "0-1" || symbol == "1/2-1/2";
+	}
+
+	bool Reader::next(Game& game) {
+		game.clear();
+
+		// tag pairs. Anything else before them (junk, stray escapes) gets skipped.
+		bool sawAnything = false;
+		while (true) {
+			skipWhitespace();
+			const int c = peek();
+			if (c == EOF) return sawAnything;
+			if (c == '[') {
+				get();
+				readTag(game);
+				sawAnything = true;
+			} else if (c == '%' || c == ';') {
+				skipLine();
+			} else if (c == '{') {
+				get();
+				skipComment();
+			} else {
+				break;
+			}
+		}
+
+		GameState state = game.start;
+		bool failed = !game.error.empty();
+		while (true) {
+			skipWhitespace();
+			const int c = peek();
+			if (c == EOF) return true;
+
+			// a tag means the last game never had a result, so it's over.
+			if (c == '[') return true;
+
+			if (c == '{') { get(); skipComment(); continue; }
+			if (c == ';') { skipLine(); continue; }
+			if (c == '(') { get(); skipVariation(); continue; }
+			if (c == '$') { get(); while (std::isdigit(peek())) get(); continue; }
+			if (c == '.' || c == ')') { get(); continue; }
+			if (c == '*') {
+				get();
+				game.result.assign(1, '*');
+				return true;
+			}
+
+			readSymbol(_symbol);
+			if (_symbol.empty()) {
+				// something we don't know, skip it so we don't get stuck.
+				get();
+				continue;
+			}
+
+			if (isResult(_symbol)) {
+				game.result = _symbol;
+				return true;
+			}
+
+			// move numbers, "12." or "12..." (the dots get skipped above).
+			if (std::isdigit((unsigned char)_symbol[0]) && _symbol.find_first_not_of("0123456789") == std::string::npos) {
+				continue;
+			}
+
+			// once a move fails, keep reading to the end of the game so the next one starts in the right place.
+			if (failed) continue;
+
+			Move move(0, 0);
+			if (!fromSAN(state, _symbol, move)) {
+				game.error = "Illegal or ambiguous move " + _symbol + " after " + std::to_string(game.moves.size()) + " plies";
+				failed = true;
+				continue;
+			}
+			game.moves.push_back(move);
+			state.MakeMove(move);
+		}
+	}
+
+	// ========================== Writing ==========================
+
+	static void writeTag(std::ostream& out, const std::string& name, const std::string& value) {
+		out << '[' << name << " \"";
+		for (const char c : value) {
+			if (c == '"' || c == '\\') out << '\\';
+			out << c;
+		}
+		out << "\"]\n";
+	}
+
+	void write(std::ostream& out, const Game& game) {
+		for (const char* name : SEVEN_TAG_ROSTER) {
+			if (std::strcmp(name, "Result") == 0) {
+				writeTag(out, name, game.result);
+				continue;
+			}
+			const std::string value = game.tag(name);
+			writeTag(out, name, value.empty() ? "?" : value);
+		}
+
+		char fen[GameState::MAX_FEN_LENGTH];
+		GameState::ToFEN(game.start, fen);
+		const bool customStart = std::strcmp(fen, START_FEN) != 0;
+		if (customStart) {
+			writeTag(out, "SetUp", "1");
+			writeTag(out, "FEN", fen);
+		}
+
+		for (const auto& [name, value] : game.tags) {
+			bool written = name == "SetUp" || name == "FEN";
+			for (const char* roster : SEVEN_TAG_ROSTER) {
+				written |= name == roster;
+			}
+			if (!written) writeTag(out, name, value);
+		}
+		out << '\n';
+
+		// movetext lines are kept under 80 characters, as export format asks.
+		std::string line;
+		auto append = [&out, &line](const std::string& token) {
+			if (!line.empty() && line.size() + 1 + token.size() > 79) {
+				out << line << '\n';
+				line.clear();
+			}
+			if (!line.empty()) line += ' ';
+			line += token;
+		};
+
+		GameState state = game.start;
+		for (size_t i = 0; i < game.moves.size(); i++) {
+			const int moveNumber = state.getClock() > 0 ? state.getClock() : 1;
+			if (!state.isBlackTurn()) {
+				append(std::to_string(moveNumber) + ".");
+			} else if (i == 0) {
+				append(std::to_string(moveNumber) + "...");
+			}
+			append(toSAN(state, game.moves[i]));
+			state.MakeMove(game.moves[i]);
+		}
+		append(game.result);
+		out << line << "\n\n";
+	}
+}
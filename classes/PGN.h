@@ -0,0 +1,66 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "GameState.h"
+#include "Move.h"
+
+// Portable Game Notation. https://www.chessprogramming.org/Portable_Game_Notation
+namespace PGN {
+	extern const char* const START_FEN;
+
+	struct Game {
+		std::vector<std::pair<std::string, std::string>> tags;
+		GameState start = GameState::FromFEN(START_FEN);
+		std::vector<Move> moves;     // main line only
+		std::string result = "*";    // "1-0", "0-1", "1/2-1/2" or "*"
+		std::string error;           // set when the movetext couldn't be decoded, moves holds everything before it
+
+		// value of a tag, or an empty string if the game doesn't have it.
+		std::string tag(const std::string_view name) const;
+		void setTag(const std::string& name, const std::string& value);
+		// empties the game, keeping allocations so a reader can reuse it for every game in a file.
+		void clear();
+	};
+
+	// Standard Algebraic Notation, ex. "Nbd2", "exd6", "e8=Q+", "O-O-O#". Both need the position the move is played from.
+	std::string toSAN(const GameState& state, const Move& move);
+	// Finds the legal move the SAN describes. Returns false if there isn't exactly one.
+	bool fromSAN(const GameState& state, const std::string_view san, Move& move);
+
+	// Pulls games out of a stream one at a time through a fixed size buffer, so memory stays flat no matter how big
+	// the file is. Comments, NAGs & variations are skipped; only the main line is kept.
+	class Reader {
+		public:
+		explicit Reader(std::istream& in) : _in(in) {}
+
+		// Reads the next game into game. Returns false once the stream runs out of games.
+		// A game with bad movetext still comes back, with game.error set.
+		bool next(Game& game);
+
+		private:
+		int peek();
+		int get();
+		void skipWhitespace();
+		void skipLine();
+		void skipComment();
+		void skipVariation();
+		void readTag(Game& game);
+		void readSymbol(std::string& symbol);
+
+		std::istream& _in;
+		char _buffer[1 << 16];
+		size_t _pos = 0;
+		size_t _end = 0;
+		std::string _symbol;
+	};
+
+	// Writes a game out with its tags (the Seven Tag Roster gets filled with "?" where missing), a FEN tag if it
+	// didn't start from the usual position, and the movetext wrapped at 80 columns.
+	void write(std::ostream& out, const Game& game);
+}
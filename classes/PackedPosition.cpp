@@ -0,0 +1,104 @@
+#include <stdexcept>
+
+#include "PackedPosition.h"
+#include "MagicBitboards/BitFunctions.h"
+
+const uint8_t SIDE_TO_MOVE_FLAG = 1 << 4;
+const int MAX_PACKED_PIECES = 32;
+const uint8_t INVALID_POS = 255; // no en passant square, same as GameState
+const uint64_t BACK_RANKS = 0xff000000000000ffULL;
+const uint64_t WHITE_EN_PASSANT_RANK = 0xffULL << 40; // white to move, so black just double pushed
+const uint64_t BLACK_EN_PASSANT_RANK = 0xffULL << 16;
+
+// king & rook squares each castling right (KQkq, high bit first) needs.
+const uint8_t CASTLING_KING_SQUARES[4] = { 4, 4, 60, 60 };
+const uint8_t CASTLING_ROOK_SQUARES[4] = { 7, 0, 63, 56 };
+
+PackedPosition PackedPosition::pack(const GameState& state) {
+	const ProtoBoard& board = state.getProtoBoard();
+	PackedPosition packed = {};
+	packed.occupancy = board.getOccupancyBoard();
+	if (popCount(packed.occupancy) > MAX_PACKED_PIECES) {
+		throw std::runtime_error("Can't pack a position with more than 32 pieces.");
+	}
+
+	// spread the bitboards out into a mailbox first, so the nibbles can be written in one pass over the occupancy.
+	ChessPiece mailbox[64];
+	for (int i = 0; i < 12; i++) {
+		const ChessPiece piece = ProtoBoard::PieceFromProtoIndex(i);
+		forEachBit([&mailbox, piece](uint8_t square) {
+			mailbox[square] = piece;
+		}, board[i]);
+	}
+
+	int n = 0;
+	forEachBit([&packed, &mailbox, &n](uint8_t square) {
+		packed.pieces[n >> 1] |= mailbox[square] << ((n & 1) * 4);
+		n++;
+	}, packed.occupancy);
+
+	packed.flags = (state.isBlackTurn() ? SIDE_TO_MOVE_FLAG : 0) | state.getCastlingRights();
+	packed.enPassantSquare = state.getEnPassantSquare();
+	packed.halfClock = state.getHalfClock();
+	packed.clock = state.getClock();
+	return packed;
+}
+
+GameState PackedPosition::unpack() const {
+	// these come straight off disk, so anything pack wouldn't have written is an error, not something to guess around.
+	if (popCount(occupancy) > MAX_PACKED_PIECES) {
+		throw std::runtime_error("Invalid packed position. More than 32 pieces.");
+	}
+
+	// nibbles are ChessPieces, so they can index straight into a bitboard per piece code. No branching on the piece.
+	uint64_t byPiece[16] = {};
+	int n = 0;
+	forEachBit([this, &byPiece, &n](uint8_t square) {
+		byPiece[(pieces[n >> 1] >> ((n & 1) * 4)) & 15] |= 1ULL << square;
+		n++;
+	}, occupancy);
+
+	ProtoBoard board;
+	for (int i = 0; i < 12; i++) {
+		const ChessPiece piece = ProtoBoard::PieceFromProtoIndex(i);
+		board.set(piece, byPiece[piece]);
+	}
+
+	if (byPiece[NoPiece] | byPiece[7] | byPiece[Black] | byPiece[7 | Black]) {
+		throw std::runtime_error("Invalid packed position. Unknown piece code.");
+	}
+	// pack leaves the nibbles past the last piece empty, anything there means the occupancy lost some squares.
+	for (int unused = n; unused < MAX_PACKED_PIECES; unused++) {
+		if ((pieces[unused >> 1] >> ((unused & 1) * 4)) & 15) {
+			throw std::runtime_error("Invalid packed position. More pieces than occupied squares.");
+		}
+	}
+	if (!byPiece[King] || !byPiece[King | Black]) {
+		throw std::runtime_error("Invalid packed position. King is missing!");
+	}
+	if (popCount(byPiece[King]) > 1 || popCount(byPiece[King | Black]) > 1) {
+		throw std::runtime_error("Invalid packed position. More than one king per side.");
+	}
+	if ((byPiece[Pawn] | byPiece[Pawn | Black]) & BACK_RANKS) {
+		throw std::runtime_error("Invalid packed position. Pawn on the back rank.");
+	}
+
+	const bool black = (flags & SIDE_TO_MOVE_FLAG) != 0;
+	if (flags & ~(SIDE_TO_MOVE_FLAG | 15)) {
+		throw std::runtime_error("Invalid packed position. Unknown flags.");
+	}
+	for (int right = 0; right < 4; right++) {
+		if (!(flags & (0b1000 >> right))) continue;
+		const ChessPiece colour = right < 2 ? NoPiece : Black;
+		if (!(byPiece[King | colour] >> CASTLING_KING_SQUARES[right] & 1) || !(byPiece[Rook | colour] >> CASTLING_ROOK_SQUARES[right] & 1)) {
+			throw std::runtime_error("Invalid packed position. Castling right without its king & rook.");
+		}
+	}
+	if (enPassantSquare != INVALID_POS
+		&& (enPassantSquare >= 64 || !((black ? BLACK_EN_PASSANT_RANK : WHITE_EN_PASSANT_RANK) >> enPassantSquare & 1))) {
+		throw std::runtime_error("Invalid packed position. Bad en passant square.");
+	}
+
+	return GameState(board, black, flags & 15, enPassantSquare, halfClock, clock,
+		bitScanForward(byPiece[King]), bitScanForward(byPiece[King | Black]));
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#include "GameState.h"
+
+// Dense binary position, 32 bytes vs the 128 of a GameState or ~60 characters of FEN.
+// Meant for anything that stores a lot of positions: TT entries, training data, game databases.
+//
+// Layout: the occupancy bitboard, then one 4 bit ChessPiece per occupied square (low nibble first, in square order),
+// which caps it at 32 pieces. Multi byte fields are in host byte order, so byteswap them if files move between machines.
+struct PackedPosition {
+	uint64_t occupancy;
+	uint8_t pieces[16];
+	uint8_t flags;           // side to move in bit 4, castling rights (KQkq) in the low nibble
+	uint8_t enPassantSquare; // 255 for none, same as GameState
+	uint8_t halfClock;
+	uint8_t reserved;
+	uint16_t clock;
+	uint16_t padding;
+
+	// Throws if there are more than 32 pieces on the board.
+	static PackedPosition pack(const GameState& state);
+	// Throws if it isn't something pack could have written (unknown piece codes, pieces not matching the occupancy,
+	// missing or extra kings, pawns on the back rank, castling rights without the pieces, a bad en passant square),
+	// ex. from a corrupt or mismatched file.
+	GameState unpack() const;
+
+	bool operator==(const PackedPosition&) const = default;
+};
+
+static_assert(sizeof(PackedPosition) == 32, "PackedPosition is supposed to be 32 bytes");
@@ -0,0 +1,122 @@
+#include <array>
+
+#include "PawnStructure.h"
+#include "MagicBitboards/BitFunctions.h"
+#include "MagicBitboards/PieceAttacks.h"
+
+// Centipawns. Rank tables are from the pawn's own side, so index 6 is one step from promoting.
+const int DOUBLED_PAWN  = -12; // per pawn past the first on a file
+const int ISOLATED_PAWN = -15;
+const int BACKWARD_PAWN = -10;
+const int PASSED_PAWN[8] = { 0, 5, 10, 20, 35, 60, 100, 0 };
+const int FREE_PASSER[8] = { 0, 0, 5, 10, 15, 25, 40, 0 };
+
+const uint64_t FILE_A = 0x0101010101010101ULL;
+
+struct PawnMasks {
+	uint64_t adjacentFiles[8];
+	uint64_t passed[2][64];   // [colour][square]: squares ahead on the same & adjacent files, no enemy pawn allowed
+	uint64_t supporters[2][64]; // adjacent files, on the pawn's rank or behind it
+};
+
+constexpr PawnMasks generatePawnMasks() {
+	PawnMasks masks {};
+	for (int file = 0; file < 8; file++) {
+		masks.adjacentFiles[file] = (file > 0 ? FILE_A << (file - 1) : 0) | (file < 7 ? FILE_A << (file + 1) : 0);
+	}
+
+	for (int square = 0; square < 64; square++) {
+		const int rank = square / 8;
+		const int file = square % 8;
+		const uint64_t span = masks.adjacentFiles[file] | FILE_A << file;
+		for (int r = 0; r < 8; r++) {
+			const uint64_t rankMask = 0xffULL << (r * 8);
+			if (r > rank) masks.passed[0][square] |= span & rankMask;
+			if (r < rank) masks.passed[1][square] |= span & rankMask;
+			if (r <= rank) masks.supporters[0][square] |= masks.adjacentFiles[file] & rankMask;
+			if (r >= rank) masks.supporters[1][square] |= masks.adjacentFiles[file] & rankMask;
+		}
+	}
+	return masks;
+}
+
+static constexpr PawnMasks masks = generatePawnMasks();
+
+namespace PawnStructure {
+	// one side's pawns, from that side's point of view.
+	static int evaluateSide(const uint64_t ours, const uint64_t theirs, const int colour, uint64_t& passed) {
+		int score = 0;
+
+		for (int file = 0; file < 8; file++) {
+			const int count = popCount(ours & (FILE_A << file));
+			if (count > 1) {
+				score += DOUBLED_PAWN * (count - 1);
+			}
+		}
+
+		forEachBit([&](uint8_t square) {
+			const int file = square % 8;
+			const int relativeRank = colour ? 7 - square / 8 : square / 8;
+
+			// the rear pawn of a doubled pair is stuck behind the front one, so only the front one counts as passed.
+			const uint64_t ahead = masks.passed[colour][square];
+			if ((theirs & ahead) == 0 && (ours & ahead & (FILE_A << file)) == 0) {
+				passed |= 1ULL << square;
+				score += PASSED_PAWN[relativeRank];
+			}
+
+			if ((ours & masks.adjacentFiles[file]) == 0) {
+				score += ISOLATED_PAWN;
+			} else if ((ours & masks.supporters[colour][square]) == 0) {
+				// every neighbour has already gone past it, so it can only be defended by advancing, and it can't
+				// advance if an enemy pawn covers the square in front. Our own pawn attacks from the stop square land
+				// exactly where those enemy pawns would be.
+				const uint8_t stop = colour ? square - 8 : square + 8;
+				if (PawnAttacks[stop][colour] & theirs) {
+					score += BACKWARD_PAWN;
+				}
+			}
+		}, ours);
+
+		return score;
+	}
+
+	int evaluate(const ProtoBoard& board, uint64_t& passed) {
+		passed = 0;
+		return evaluateSide(board[0], board[6], 0, passed) - evaluateSide(board[6], board[0], 1, passed);
+	}
+
+	int evaluatePassers(const ProtoBoard& board, const uint64_t passed) {
+		const uint64_t occupied = board.getOccupancyBoard();
+		int score = 0;
+		forEachBit([&](uint8_t square) {
+			const bool black = (board[6] >> square) & 1;
+			const uint8_t stop = black ? square - 8 : square + 8;
+			if ((occupied >> stop) & 1) return;
+			const int relativeRank = black ? 7 - square / 8 : square / 8;
+			score += black ? -FREE_PASSER[relativeRank] : FREE_PASSER[relativeRank];
+		}, passed);
+		return score;
+	}
+}
+
+PawnHashTable::PawnHashTable(const size_t entries) {
+	size_t size = 1;
+	while (size * 2 <= entries) size *= 2;
+	// zeroed entries are already right: key 0 is the empty structure, which scores 0 with no passers.
+	_entries.resize(size, Entry { 0, 0, 0 });
+	_mask = size - 1;
+}
+
+const PawnHashTable::Entry& PawnHashTable::probe(const uint64_t pawnKey, const ProtoBoard& board) {
+	Entry& entry = _entries[pawnKey & _mask];
+	_probes++;
+	if (entry.key == pawnKey) {
+		_hits++;
+		return entry;
+	}
+
+	entry.key = pawnKey;
+	entry.score = PawnStructure::evaluate(board, entry.passed);
+	return entry;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MagicBitboards/ProtoBoard.h"
+
+// Pawn structure evaluation: doubled, isolated, backward & passed pawns. https://www.chessprogramming.org/Pawn_Structure
+// Everything here only depends on where the pawns are, and pawns hardly move during a search, so results get cached
+// by pawn key in a PawnHashTable and the actual work runs once per structure instead of at every leaf.
+namespace PawnStructure {
+	// Score from white's point of view. Fills passed with both sides' passed pawns (colours can't share a square,
+	// so one bitboard holds both).
+	int evaluate(const ProtoBoard& board, uint64_t& passed);
+
+	// The part of passed pawn scoring that depends on the other pieces too, so it can't be cached:
+	// a passer whose next square is empty is worth more. White's point of view.
+	int evaluatePassers(const ProtoBoard& board, const uint64_t passed);
+}
+
+// Direct mapped, always replace. One per searcher, so no locking.
+class PawnHashTable {
+	public:
+	struct Entry {
+		uint64_t key;
+		uint64_t passed;
+		int32_t score;
+	};
+
+	// size in entries, rounded down to a power of two. 16K entries is 384KB.
+	explicit PawnHashTable(const size_t entries = 1 << 14);
+
+	// the entry for this structure, evaluating it first if it isn't cached.
+	const Entry& probe(const uint64_t pawnKey, const ProtoBoard& board);
+
+	uint64_t hits() const { return _hits; }
+	uint64_t probes() const { return _probes; }
+	void resetStats() { _hits = _probes = 0; }
+
+	private:
+	std::vector<Entry> _entries;
+	uint64_t _mask;
+	uint64_t _hits = 0;
+	uint64_t _probes = 0;
+};
@@ -0,0 +1,51 @@
+#include "PieceActivity.h"
+#include "MagicBitboards/BitFunctions.h"
+#include "MagicBitboards/MagicBitboards.h"
+#include "MagicBitboards/PieceAttacks.h"
+
+// Indexed by ProtoBoard index within a side, pawns & kings don't get counted.
+// Centipawns per safe square, counted from around the usual number so an average piece scores roughly nothing.
+const int MOBILITY_WEIGHT[6]   = { 0, 4, 5, 2, 1, 0 };
+const int MOBILITY_BASELINE[6] = { 0, 4, 6, 7, 13, 0 };
+// per attacked square in the enemy king's zone.
+const int KING_ATTACK_WEIGHT[6] = { 0, 10, 10, 20, 40, 0 };
+// percent of the attack weight that counts, by number of pieces attacking the zone.
+const int KING_ATTACKERS_SCALE[8] = { 0, 0, 50, 75, 88, 94, 97, 99 };
+
+namespace PieceActivity {
+	// one side's activity, from that side's point of view.
+	static int evaluateSide(const ProtoBoard& board, const int colour) {
+		const int ours   = colour * 6;
+		const int theirs = (colour ^ 1) * 6;
+		const uint64_t occupied = board.getOccupancyBoard();
+		const uint64_t friendly = colour ? board.getBlackOccupancyBoard() : board.getWhiteOccupancyBoard();
+		const uint64_t pawnCover = colour ? WHITE_PAWN_ATTACKS(board[theirs]) : BLACK_PAWN_ATTACKS(board[theirs]);
+		const uint64_t safe = ~friendly & ~pawnCover;
+
+		const uint8_t king = bitScanForward(board[theirs + 5]);
+		const uint64_t kingZone = KingAttacks[king] | (1ULL << king);
+
+		int score = 0;
+		int attackers = 0;
+		int attackWeight = 0;
+		auto tally = [&](const int piece, const uint64_t attacks) {
+			score += MOBILITY_WEIGHT[piece] * (popCount(attacks & safe) - MOBILITY_BASELINE[piece]);
+			const uint64_t zoneAttacks = attacks & kingZone;
+			if (zoneAttacks) {
+				attackers++;
+				attackWeight += KING_ATTACK_WEIGHT[piece] * popCount(zoneAttacks);
+			}
+		};
+
+		forEachBit([&](uint8_t square) { tally(1, KnightAttacks[square]); }, board[ours + 1]);
+		forEachBit([&](uint8_t square) { tally(2, getBishopAttacks(square, occupied)); }, board[ours + 2]);
+		forEachBit([&](uint8_t square) { tally(3, getRookAttacks(square, occupied)); }, board[ours + 3]);
+		forEachBit([&](uint8_t square) { tally(4, getQueenAttacks(square, occupied)); }, board[ours + 4]);
+
+		return score + attackWeight * KING_ATTACKERS_SCALE[attackers < 7 ? attackers : 7] / 100;
+	}
+
+	int evaluate(const ProtoBoard& board) {
+		return evaluateSide(board, 0) - evaluateSide(board, 1);
+	}
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "MagicBitboards/ProtoBoard.h"
+
+// Mobility & king safety. https://www.chessprogramming.org/Mobility https://www.chessprogramming.org/King_Safety
+// Both come out of the same attack sets: every knight, bishop, rook & queen has its attacks looked up once (the same
+// magic & step tables move generation uses), then those get counted twice:
+//  - mobility: squares it could go to that aren't ours or covered by an enemy pawn.
+//  - king safety: how hard it hits the squares around the enemy king. More attackers count for more than their sum,
+//    a lone piece near the king is rarely a threat, three of them usually are.
+namespace PieceActivity {
+	// Score from white's point of view.
+	int evaluate(const ProtoBoard& board);
+}
@@ -0,0 +1,96 @@
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "PieceSquare.h"
+#include "MagicBitboards/BitFunctions.h"
+#include "MagicBitboards/EvaluationTables.h"
+
+namespace PieceSquare {
+	// Indexed by ProtoBoard index, flipped & negated for black. Kings only have their value, which cancels out since
+	// both are always on the board, but it's kept so this matches summing every piece.
+	struct alignas(64) Tables {
+		int16_t combined[12][64]; // value + table entry, for the scalar loop
+		int8_t squares[12][64];   // just the table entry, for the kernel
+		int values[12];           // just the value, the kernel multiplies it by a popcount
+		bool squaresFit;          // every table entry fits in a byte, otherwise the kernel can't be used
+	};
+
+	static Tables buildTables() {
+		const int pieceValues[6] = { pawnValue, knightValue, bishopValue, rookValue, queenValue, kingValue };
+		const int* squareTables[6] = { pawnTable, knightTable, bishopTable, rookTable, queenTable, nullptr };
+
+		Tables tables;
+		tables.squaresFit = true;
+		for (int index = 0; index < 12; index++) {
+			const int piece = index % 6;
+			const int sign = index >= 6 ? -1 : 1;
+			tables.values[index] = sign * pieceValues[piece];
+			for (int square = 0; square < 64; square++) {
+				const int entry = squareTables[piece] ? sign * squareTables[piece][sign < 0 ? square ^ 56 : square] : 0;
+				tables.combined[index][square] = (int16_t)(tables.values[index] + entry);
+				tables.squares[index][square] = (int8_t)entry;
+				tables.squaresFit &= entry >= INT8_MIN && entry <= INT8_MAX;
+			}
+		}
+		return tables;
+	}
+
+	static const Tables tables = buildTables();
+
+	int evaluateScalar(const ProtoBoard& board) {
+		int score = 0;
+		for (int index = 0; index < 12; index++) {
+			const int16_t* row = tables.combined[index];
+			forEachBit([&score, row](uint8_t square) {
+				score += row[square];
+			}, board[index]);
+		}
+		return score;
+	}
+
+	int evaluate(const ProtoBoard& board) {
+#if defined(__AVX2__)
+		// hand tuned tables stay well inside a byte, but chess_tune doesn't promise to.
+		if (!tables.squaresFit) return evaluateScalar(board);
+
+		int score = 0;
+		for (int index = 0; index < 12; index++) {
+			score += tables.values[index] * popCount(board[index]);
+		}
+
+		// Spreads 32 squares of a bitboard into a byte mask: copy byte k of them into 8 lanes, then each lane keeps
+		// one bit of it. The whole bitboard is broadcast once (straight from memory, which keeps it off the shuffle
+		// port) and each half picks its own 4 bytes out of it. A square only ever holds one piece, so every byte lane
+		// of the sums ends up with at most one table entry and can't overflow.
+		const __m256i spreadLow  = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+			2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+		const __m256i spreadHigh = _mm256_setr_epi8(4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5,
+			6, 6, 6, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7);
+		const __m256i bits = _mm256_set1_epi64x(0x8040201008040201LL);
+		__m256i low = _mm256_setzero_si256();  // squares 0-31
+		__m256i high = _mm256_setzero_si256(); // squares 32-63
+		for (int index = 0; index < 12; index++) {
+			const __m256i bitboard = _mm256_set1_epi64x((int64_t)board[index]);
+			const __m256i* row = reinterpret_cast<const __m256i*>(tables.squares[index]);
+			const __m256i lowSquares  = _mm256_and_si256(_mm256_shuffle_epi8(bitboard, spreadLow), bits);
+			const __m256i highSquares = _mm256_and_si256(_mm256_shuffle_epi8(bitboard, spreadHigh), bits);
+			low  = _mm256_add_epi8(low,  _mm256_and_si256(_mm256_cmpeq_epi8(lowSquares, bits), row[0]));
+			high = _mm256_add_epi8(high, _mm256_and_si256(_mm256_cmpeq_epi8(highSquares, bits), row[1]));
+		}
+
+		// maddubs with ones is a signed byte pair sum, then on to int32 for the rest.
+		const __m256i ones8 = _mm256_set1_epi8(1);
+		const __m256i pairs = _mm256_add_epi16(_mm256_maddubs_epi16(ones8, low), _mm256_maddubs_epi16(ones8, high));
+		const __m256i sum = _mm256_madd_epi16(pairs, _mm256_set1_epi16(1));
+		__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0b01001110));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0b10110001));
+		return score + _mm_cvtsi128_si32(half);
+#else
+		return evaluateScalar(board);
+#endif
+	}
+}
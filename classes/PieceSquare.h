@@ -0,0 +1,16 @@
+#pragma once
+
+#include "MagicBitboards/ProtoBoard.h"
+
+// Material & piece square tables, the part of the evaluation that's a plain sum over every piece on the board.
+// The scalar version walks every bit of the 12 bitboards. The SIMD kernel doesn't loop over bits at all: material is a
+// popcount per bitboard, and for the tables each bitboard gets spread into a byte mask (one lane per square) that
+// picks its entries out of an int8 copy of the table, 32 squares at a time.
+// The kernel needs AVX2 (see CHESS_USE_AVX2), otherwise evaluate is just the scalar version. There's no SSSE3 one like
+// NNUE has: at half the width, and without hardware popcount for the material, it came out slower than scalar.
+namespace PieceSquare {
+	// White's point of view.
+	int evaluate(const ProtoBoard& board);
+	// The per-bit loop evaluate is checked against (chess_bench eval). Always the same result.
+	int evaluateScalar(const ProtoBoard& board);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+
+#include "GameState.h"
+#include "Move.h"
+#include "NNUE.h"
+
+// deepest a search (or perft) is allowed to go, including extensions.
+const int MAX_PLY = 128;
+
+// The position at every ply of a search. How moves get played is picked at compile time:
+//  - CHESS_COPY_MAKE: every ply has its own preallocated GameState. Playing a move copies the parent into the
+//    next slot & makes the move there, so going back up is just moving the index, nothing gets undone.
+//  - otherwise: one GameState is made & unmade in place, and each ply keeps the GameStateMemory unmake needs.
+// Both are here so they can be benchmarked against each other, see cli/bench.cpp.
+//
+// When a network is loaded, every ply also has an NNUE accumulator, updated from its parent's as moves are played.
+// It lives here rather than in GameState so copying a state stays cheap.
+class PlyStack {
+	public:
+	explicit PlyStack(const GameState& root, const int maxPly = MAX_PLY)
+#ifdef CHESS_COPY_MAKE
+		: _states(maxPly + 1, root), _accumulators(maxPly + 1) {
+#else
+		: _state(root), _memory(maxPly + 1), _accumulators(maxPly + 1) {
+#endif
+		if (NNUE::isLoaded()) {
+			NNUE::refresh(_accumulators[0], root);
+		}
+	}
+
+	// starts over from a new root, keeping the allocations.
+	void reset(const GameState& root) {
+		_ply = 0;
+		current() = root;
+		if (NNUE::isLoaded()) {
+			NNUE::refresh(_accumulators[0], root);
+		}
+	}
+
+	GameState& current() {
+#ifdef CHESS_COPY_MAKE
+		return _states[_ply];
+#else
+		return _state;
+#endif
+	}
+
+	const GameState& current() const {
+#ifdef CHESS_COPY_MAKE
+		return _states[_ply];
+#else
+		return _state;
+#endif
+	}
+
+	// only valid while a network is loaded.
+	const NNUE::Accumulator& accumulator() const { return _accumulators[_ply]; }
+
+	void push(const Move& move) {
+#ifdef CHESS_COPY_MAKE
+		GameState& next = _states[_ply + 1];
+		next = _states[_ply];
+		next.MakeMove(move);
+		if (NNUE::isLoaded()) {
+			NNUE::update(_accumulators[_ply + 1], _accumulators[_ply], _states[_ply].getProtoBoard(), next);
+		}
+#else
+		_memory[_ply] = _state.makeMemoryState();
+		if (NNUE::isLoaded()) {
+			const ProtoBoard before = _state.getProtoBoard();
+			_state.MakeMove(move);
+			NNUE::update(_accumulators[_ply + 1], _accumulators[_ply], before, _state);
+		} else {
+			_state.MakeMove(move);
+		}
+#endif
+		_ply++;
+	}
+
+	void pop(const Move& move) {
+		_ply--;
+#ifndef CHESS_COPY_MAKE
+		_state.UnmakeMove(move, _memory[_ply]);
+#endif
+	}
+
+	int ply() const { return _ply; }
+
+	private:
+#ifdef CHESS_COPY_MAKE
+	std::vector<GameState> _states;
+#else
+	GameState _state;
+	std::vector<GameStateMemory> _memory;
+#endif
+	std::vector<NNUE::Accumulator> _accumulators;
+	int _ply = 0;
+};
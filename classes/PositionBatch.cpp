@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "PositionBatch.h"
+#include "MagicBitboards/BitFunctions.h"
+#include "MagicBitboards/MagicBitboards.h"
+
+const uint64_t FILE_A = 0x0101010101010101ULL;
+const uint64_t FILE_B = FILE_A << 1;
+const uint64_t FILE_G = FILE_A << 6;
+const uint64_t FILE_H = FILE_A << 7;
+const uint64_t RANK_3 = 0xffULL << 16;
+const uint64_t RANK_8 = 0xffULL << 56;
+
+// One bitboard per lane. Everything the set-wise part of generation needs, with AVX2 underneath when we have it.
+#if defined(__AVX2__)
+struct Lanes {
+	__m256i v;
+
+	static Lanes load(const uint64_t* p) { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)) }; }
+	static Lanes fill(const uint64_t x) { return { _mm256_set1_epi64x((int64_t)x) }; }
+	void store(uint64_t* p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+	Lanes operator&(const Lanes other) const { return { _mm256_and_si256(v, other.v) }; }
+	Lanes operator|(const Lanes other) const { return { _mm256_or_si256(v, other.v) }; }
+	Lanes operator+(const Lanes other) const { return { _mm256_add_epi64(v, other.v) }; }
+	Lanes operator~() const { return { _mm256_xor_si256(v, _mm256_set1_epi64x(-1)) }; }
+	Lanes operator&(const uint64_t mask) const { return *this & fill(mask); }
+
+	// positive goes up the board, negative down.
+	Lanes shift(const int amount) const {
+		return { amount >= 0 ? _mm256_slli_epi64(v, amount) : _mm256_srli_epi64(v, -amount) };
+	}
+
+	// AVX2 has no 64 bit popcount, so count nibbles with a table lookup & add the bytes of each lane up.
+	Lanes popCount() const {
+		const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i nibble = _mm256_set1_epi8(0x0f);
+		const __m256i low  = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+		const __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi64(v, 4), nibble));
+		return { _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()) };
+	}
+};
+#else
+struct Lanes {
+	uint64_t v[PositionBatch::BATCH_LANES];
+
+	static Lanes load(const uint64_t* p) {
+		Lanes lanes;
+		for (size_t i = 0; i < PositionBatch::BATCH_LANES; i++) lanes.v[i] = p[i];
+		return lanes;
+	}
+	static Lanes fill(const uint64_t x) {
+		Lanes lanes;
+		for (size_t i = 0; i < PositionBatch::BATCH_LANES; i++) lanes.v[i] = x;
+		return lanes;
+	}
+	void store(uint64_t* p) const {
+		for (size_t i = 0; i < PositionBatch::BATCH_LANES; i++) p[i] = v[i];
+	}
+
+	template<typename F>
+	Lanes map(F&& f) const {
+		Lanes lanes;
+		for (size_t i = 0; i < PositionBatch::BATCH_LANES; i++) lanes.v[i] = f(v[i], i);
+		return lanes;
+	}
+
+	Lanes operator&(const Lanes other) const { return map([&other](uint64_t x, size_t i) { return x & other.v[i]; }); }
+	Lanes operator|(const Lanes other) const { return map([&other](uint64_t x, size_t i) { return x | other.v[i]; }); }
+	Lanes operator+(const Lanes other) const { return map([&other](uint64_t x, size_t i) { return x + other.v[i]; }); }
+	Lanes operator~() const { return map([](uint64_t x, size_t) { return ~x; }); }
+	Lanes operator&(const uint64_t mask) const { return map([mask](uint64_t x, size_t) { return x & mask; }); }
+
+	Lanes shift(const int amount) const {
+		return map([amount](uint64_t x, size_t) { return amount >= 0 ? x << amount : x >> -amount; });
+	}
+
+	Lanes popCount() const { return map([](uint64_t x, size_t) { return (uint64_t)::popCount(x); }); }
+};
+#endif
+
+// A step every piece of a kind takes at once: shift by this much, after dropping the pieces it'd wrap round the board.
+struct Step {
+	int shift;
+	uint64_t from;
+};
+
+static const Step KNIGHT_STEPS[8] = {
+	{ 17, ~FILE_H }, { 15, ~FILE_A }, { 10, ~(FILE_G | FILE_H) }, { 6, ~(FILE_A | FILE_B) },
+	{ -15, ~FILE_H }, { -17, ~FILE_A }, { -6, ~(FILE_G | FILE_H) }, { -10, ~(FILE_A | FILE_B) },
+};
+
+static const Step KING_STEPS[8] = {
+	{ 8, ~0ULL }, { -8, ~0ULL }, { 1, ~FILE_H }, { -1, ~FILE_A },
+	{ 9, ~FILE_H }, { 7, ~FILE_A }, { -7, ~FILE_H }, { -9, ~FILE_A },
+};
+
+static inline uint64_t flipVertical(const uint64_t bitboard) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	return _byteswap_uint64(bitboard);
+#else
+	return __builtin_bswap64(bitboard);
+#endif
+}
+
+void PositionBatch::add(const GameState& state) {
+	if (_count == _pieces[0].size()) {
+		for (std::vector<uint64_t>& pieces : _pieces) {
+			pieces.resize(_count + BATCH_LANES, 0);
+		}
+		_castling.resize(_count + BATCH_LANES, 0);
+		_enPassant.resize(_count + BATCH_LANES, 255);
+		_flipped.resize(_count + BATCH_LANES, 0);
+	}
+
+	const ProtoBoard& board = state.getProtoBoard();
+	const bool black = state.isBlackTurn();
+	for (int index = 0; index < 12; index++) {
+		_pieces[index][_count] = black ? flipVertical(board[(index + 6) % 12]) : board[index];
+	}
+
+	const uint8_t rights = state.getCastlingRights();
+	_castling[_count] = ((rights & (black ? 0b0010 : 0b1000)) ? 1 : 0) | ((rights & (black ? 0b0001 : 0b0100)) ? 2 : 0);
+	const uint8_t enPassant = state.getEnPassantSquare();
+	_enPassant[_count] = (black && enPassant < 64) ? enPassant ^ 56 : enPassant;
+	_flipped[_count] = black;
+	_count++;
+}
+
+void PositionBatch::clear() {
+	for (std::vector<uint64_t>& pieces : _pieces) {
+		pieces.clear();
+	}
+	_castling.clear();
+	_enPassant.clear();
+	_flipped.clear();
+	_count = 0;
+}
+
+void PositionBatch::countMoves(uint32_t* counts) const {
+	generate<false>(counts, nullptr);
+}
+
+void PositionBatch::generateMoves(std::vector<Move>* lists) const {
+	generate<true>(nullptr, lists);
+}
+
+// Everything below is from white's point of view, since that's how the positions are stored.
+template<bool Emit>
+void PositionBatch::generate(uint32_t* counts, std::vector<Move>* lists) const {
+	for (size_t base = 0; base < _count; base += BATCH_LANES) {
+		const size_t lanes = std::min(BATCH_LANES, _count - base);
+
+		// Per lane: checks, pins & what the enemy sliders see past our king. Padding lanes stay empty.
+		uint64_t checkMasks[BATCH_LANES] = {};
+		uint64_t pinnedMasks[BATCH_LANES] = {};
+		uint64_t sliderDanger[BATCH_LANES] = {};
+		for (size_t lane = 0; lane < lanes; lane++) {
+			const size_t i = base + lane;
+			const uint64_t friendly = _pieces[0][i] | _pieces[1][i] | _pieces[2][i] | _pieces[3][i] | _pieces[4][i] | _pieces[5][i];
+			const uint64_t enemies  = _pieces[6][i] | _pieces[7][i] | _pieces[8][i] | _pieces[9][i] | _pieces[10][i] | _pieces[11][i];
+			const uint64_t occupancy = friendly | enemies;
+			const uint8_t king = bitScanForward(_pieces[5][i]);
+			const uint64_t cardinals = _pieces[9][i] | _pieces[10][i];
+			const uint64_t ordinals  = _pieces[8][i] | _pieces[10][i];
+
+			const uint64_t checkers = (getRookAttacks(king, occupancy) & cardinals) | (getBishopAttacks(king, occupancy) & ordinals)
+				| (KnightAttacks[king] & _pieces[7][i]) | (PawnAttacks[king][0] & _pieces[6][i]);
+			if (!checkers) {
+				checkMasks[lane] = ~0ULL;
+			} else if ((checkers & (checkers - 1)) == 0) {
+				checkMasks[lane] = BetweenMask[king][bitScanForward(checkers)] | checkers;
+			}
+
+			const uint64_t snipers = (getRookAttacks(king, enemies) & cardinals) | (getBishopAttacks(king, enemies) & ordinals);
+			forEachBit([&](uint8_t sniper) {
+				const uint64_t blockers = BetweenMask[king][sniper] & occupancy;
+				if (blockers && (blockers & (blockers - 1)) == 0 && (blockers & friendly)) {
+					pinnedMasks[lane] |= blockers;
+				}
+			}, snipers);
+
+			// the king's taken off so he can't hide behind himself from a slider that's checking him.
+			const uint64_t kingless = occupancy ^ _pieces[5][i];
+			forEachBit([&](uint8_t square) {
+				sliderDanger[lane] |= getRookAttacks(square, kingless);
+			}, cardinals);
+			forEachBit([&](uint8_t square) {
+				sliderDanger[lane] |= getBishopAttacks(square, kingless);
+			}, ordinals);
+		}
+
+		// moves out of a lane's target bitboard, each target coming from (to - offset). Pawns reaching the last rank promote.
+		uint32_t extra[BATCH_LANES] = {};
+		auto emitTargets = [&](const size_t lane, const uint64_t targets, const int offset, const uint8_t flags, const bool pawn) {
+			const size_t i = base + lane;
+			const uint8_t flip = _flipped[i] ? 56 : 0;
+			forEachBit([&](uint8_t to) {
+				if (pawn && ((1ULL << to) & RANK_8)) {
+					for (int promotion = 0; promotion < 4; promotion++) {
+						lists[i].emplace_back((to - offset) ^ flip, to ^ flip, Move::FlagCodes::ToQueen << promotion);
+					}
+				} else {
+					lists[i].emplace_back((to - offset) ^ flip, to ^ flip, flags);
+				}
+			}, targets);
+		};
+
+		// The set-wise part, every lane at once.
+		Lanes us[6], them[6];
+		for (int piece = 0; piece < 6; piece++) {
+			us[piece]   = Lanes::load(&_pieces[piece][base]);
+			them[piece] = Lanes::load(&_pieces[piece + 6][base]);
+		}
+		const Lanes friendly = us[0] | us[1] | us[2] | us[3] | us[4] | us[5];
+		const Lanes enemies  = them[0] | them[1] | them[2] | them[3] | them[4] | them[5];
+		const Lanes empty = ~(friendly | enemies);
+		const Lanes checkMask = Lanes::load(checkMasks);
+		const Lanes unpinned  = ~Lanes::load(pinnedMasks);
+
+		// enemy pawns attack downwards.
+		Lanes danger = Lanes::load(sliderDanger) | (them[0] & ~FILE_H).shift(-7) | (them[0] & ~FILE_A).shift(-9);
+		for (const Step& step : KNIGHT_STEPS) {
+			danger = danger | (them[1] & step.from).shift(step.shift);
+		}
+		for (const Step& step : KING_STEPS) {
+			danger = danger | (them[5] & step.from).shift(step.shift);
+		}
+
+		Lanes total = Lanes::fill(0);
+		auto addTargets = [&](const Lanes targets, const int offset, const uint8_t flags, const bool pawn) {
+			if constexpr (Emit) {
+				uint64_t perLane[BATCH_LANES];
+				targets.store(perLane);
+				for (size_t lane = 0; lane < lanes; lane++) {
+					emitTargets(lane, perLane[lane], offset, flags, pawn);
+				}
+			} else {
+				total = total + targets.popCount();
+			}
+		};
+
+		const Lanes notFriendly = ~friendly;
+		for (const Step& step : KING_STEPS) {
+			addTargets((us[5] & step.from).shift(step.shift) & notFriendly & ~danger, step.shift, 0, false);
+		}
+		const Lanes knights = us[1] & unpinned;
+		for (const Step& step : KNIGHT_STEPS) {
+			addTargets((knights & step.from).shift(step.shift) & notFriendly & checkMask, step.shift, 0, false);
+		}
+
+		const Lanes pawns = us[0] & unpinned;
+		const Lanes singles = pawns.shift(8) & empty;
+		const Lanes pushes  = singles & checkMask;
+		const Lanes doubles = (singles & RANK_3).shift(8) & empty & checkMask;
+		const Lanes west = (pawns & ~FILE_A).shift(7) & enemies & checkMask;
+		const Lanes east = (pawns & ~FILE_H).shift(9) & enemies & checkMask;
+		addTargets(pushes, 8, 0, true);
+		addTargets(doubles, 16, Move::FlagCodes::DoublePush, true);
+		addTargets(west, 7, 0, true);
+		addTargets(east, 9, 0, true);
+		if constexpr (!Emit) {
+			// every promotion is 4 moves, one's already been counted. Two pawns can capture onto the same square, so
+			// the directions can't be merged first.
+			const Lanes promotions = (pushes & RANK_8).popCount() + (west & RANK_8).popCount() + (east & RANK_8).popCount();
+			total = total + promotions + promotions + promotions;
+		}
+
+		uint64_t dangerMasks[BATCH_LANES];
+		danger.store(dangerMasks);
+
+		// Per lane again: sliders, pinned pawns, en passant & castling.
+		for (size_t lane = 0; lane < lanes; lane++) {
+			const size_t i = base + lane;
+			const uint64_t ours = _pieces[0][i] | _pieces[1][i] | _pieces[2][i] | _pieces[3][i] | _pieces[4][i] | _pieces[5][i];
+			const uint64_t theirs = _pieces[6][i] | _pieces[7][i] | _pieces[8][i] | _pieces[9][i] | _pieces[10][i] | _pieces[11][i];
+			const uint64_t occupancy = ours | theirs;
+			const uint8_t king = bitScanForward(_pieces[5][i]);
+			const uint64_t allowed = checkMasks[lane];
+			const uint64_t pinned = pinnedMasks[lane];
+
+			auto addMoves = [&](const uint8_t from, uint64_t targets) {
+				if (pinned & (1ULL << from)) targets &= ColinearMask[from][king];
+				if constexpr (Emit) {
+					forEachBit([&](uint8_t to) {
+						emitTargets(lane, 1ULL << to, to - from, 0, false);
+					}, targets);
+				} else {
+					extra[lane] += popCount(targets);
+				}
+			};
+
+			forEachBit([&](uint8_t from) {
+				addMoves(from, getRookAttacks(from, occupancy) & ~ours & allowed);
+			}, _pieces[3][i] | _pieces[4][i]);
+			forEachBit([&](uint8_t from) {
+				addMoves(from, getBishopAttacks(from, occupancy) & ~ours & allowed);
+			}, _pieces[2][i] | _pieces[4][i]);
+
+			// pinned pawns one at a time, pinned knights can never move.
+			forEachBit([&](uint8_t from) {
+				const uint64_t single = (1ULL << (from + 8)) & ~occupancy;
+				const uint64_t targets = single | ((single & RANK_3) << 8 & ~occupancy) | (PawnAttacks[from][0] & theirs);
+				const uint64_t legal = targets & allowed & ColinearMask[from][king];
+				if constexpr (Emit) {
+					forEachBit([&](uint8_t to) {
+						emitTargets(lane, 1ULL << to, to - from, to - from == 16 ? Move::FlagCodes::DoublePush : 0, true);
+					}, legal);
+				} else {
+					extra[lane] += popCount(legal) + 3 * popCount(legal & RANK_8);
+				}
+			}, _pieces[0][i] & pinned);
+
+			// en passant, checked by looking at the position after since two pieces leave the rank.
+			const uint8_t epSquare = _enPassant[i];
+			if (epSquare < 64) {
+				const uint64_t epBit = 1ULL << epSquare;
+				const uint64_t capturedBit = epBit >> 8;
+				if (allowed & (epBit | capturedBit)) {
+					const uint64_t cardinals = _pieces[9][i] | _pieces[10][i];
+					const uint64_t ordinals  = _pieces[8][i] | _pieces[10][i];
+					forEachBit([&](uint8_t from) {
+						const uint64_t after = (occupancy ^ (1ULL << from) ^ capturedBit) | epBit;
+						if (getRookAttacks(king, after) & cardinals) return;
+						if (getBishopAttacks(king, after) & ordinals) return;
+						if constexpr (Emit) {
+							emitTargets(lane, epBit, epSquare - from, Move::FlagCodes::EnCapture, false);
+						} else {
+							extra[lane]++;
+						}
+					}, PawnAttacks[epSquare][1] & _pieces[0][i]);
+				}
+			}
+
+			// castling, only ever from e1 since that's the only way to still have the rights.
+			if (allowed == ~0ULL) {
+				const uint64_t danger = dangerMasks[lane];
+				if ((_castling[i] & 1) && (occupancy & 0x60ULL) == 0 && (danger & 0x60ULL) == 0) {
+					if constexpr (Emit) emitTargets(lane, 1ULL << 6, 2, Move::FlagCodes::KCastle, false); else extra[lane]++;
+				}
+				if ((_castling[i] & 2) && (occupancy & 0x0eULL) == 0 && (danger & 0x0cULL) == 0) {
+					if constexpr (Emit) emitTargets(lane, 1ULL << 2, -2, Move::FlagCodes::QCastle, false); else extra[lane]++;
+				}
+			}
+		}
+
+		if constexpr (!Emit) {
+			uint64_t perLane[BATCH_LANES];
+			total.store(perLane);
+			for (size_t lane = 0; lane < lanes; lane++) {
+				counts[base + lane] = (uint32_t)(perLane[lane] + extra[lane]);
+			}
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "GameState.h"
+#include "Move.h"
+
+// Legal move generation for lots of independent positions at once, for perft's last ply & dataset processing.
+// Positions are stored structure of arrays (bitboard i of every position side by side) and worked through
+// BATCH_LANES at a time. Every position is stored from the side to move's point of view (flipped & colour swapped
+// when black's to move), so each lane can run the same set-wise code no matter whose turn it is:
+//  - knight, king & pawn moves, and everything the other side attacks with those, are shifts of whole bitboards,
+//    which run for every lane at once with AVX2 (see CHESS_USE_AVX2), otherwise one lane at a time.
+//  - checks, pins, sliders, en passant & castling are worked out per lane, they're table lookups anyway.
+// Same moves as Chess::MoveGenerator, not necessarily in the same order.
+class PositionBatch {
+	public:
+	static const size_t BATCH_LANES = 4;
+
+	void add(const GameState& state);
+	void clear();
+	size_t size() const { return _count; }
+
+	// counts[i] = number of legal moves in the i'th position added.
+	void countMoves(uint32_t* counts) const;
+	// appends each position's legal moves to lists[i].
+	void generateMoves(std::vector<Move>* lists) const;
+
+	private:
+	template<bool Emit>
+	void generate(uint32_t* counts, std::vector<Move>* lists) const;
+
+	// _pieces[0-5] are the side to move's pawns, knights, bishops, rooks, queens & king, [6-11] the other side's.
+	// Padded with empty positions up to a multiple of BATCH_LANES.
+	std::vector<uint64_t> _pieces[12];
+	std::vector<uint8_t> _castling;  // bit 0 kingside, bit 1 queenside, for the side to move
+	std::vector<uint8_t> _enPassant; // flipped like the board, 255 for none
+	std::vector<uint8_t> _flipped;   // black to move, squares have to be flipped back for moves
+	size_t _count = 0;
+};
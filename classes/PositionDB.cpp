@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <queue>
+#include <stdexcept>
+
+#include "PositionDB.h"
+#include "Zobrist.h"
+#include "MagicBitboards/PieceAttacks.h"
+
+static const char MAGIC[8] = {'C', 'H', 'E', 'S', 'S', 'P', 'D', 'B'};
+
+static bool entryLess(const PositionDB::Entry& a, const PositionDB::Entry& b) {
+	return a.key != b.key ? a.key < b.key : a.move < b.move;
+}
+
+static bool sameEntry(const PositionDB::Entry& a, const PositionDB::Entry& b) {
+	return a.key == b.key && a.move == b.move;
+}
+
+static void addCounts(PositionDB::Entry& into, const PositionDB::Entry& from) {
+	into.white += from.white;
+	into.draws += from.draws;
+	into.black += from.black;
+}
+
+uint64_t PositionDB::keyFor(const GameState& state) {
+	const ProtoBoard& board = state.getProtoBoard();
+	uint8_t enPassant = state.getEnPassantSquare();
+	if (enPassant < 64) {
+		// our pawns that can take on the square sit wherever an enemy pawn standing on it would attack.
+		const bool isBlack = state.isBlackTurn();
+		const uint64_t pawns = board[isBlack ? 6 : 0];
+		if ((PawnAttacks[enPassant][isBlack ? 0 : 1] & pawns) == 0) {
+			enPassant = 255;
+		}
+	}
+	return Zobrist::computeKey(board, state.isBlackTurn(), state.getCastlingRights(), enPassant);
+}
+
+uint32_t PositionDB::packMove(const Move& move) {
+	return move.getTo() | (uint32_t)move.getFrom() << 6 | (uint32_t)move.getFlags() << 12;
+}
+
+bool PositionDB::open(const std::string& path) {
+	close();
+	if (!_file.open(path)) return false;
+
+	if (_file.size() < sizeof(Header)) {
+		_file.close();
+		return false;
+	}
+	Header header;
+	std::memcpy(&header, _file.data(), sizeof(Header));
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+		header.entrySize != sizeof(Entry) || _file.size() < sizeof(Header) + header.count * sizeof(Entry)) {
+		_file.close();
+		return false;
+	}
+
+	// the header's a multiple of 8 bytes and mappings are page aligned, so the entries can be used in place.
+	_entries = reinterpret_cast<const Entry*>(_file.data() + sizeof(Header));
+	_count = header.count;
+	return true;
+}
+
+void PositionDB::close() {
+	_file.close();
+	_entries = nullptr;
+	_count = 0;
+}
+
+std::span<const PositionDB::Entry> PositionDB::find(const uint64_t key) const {
+	if (!_entries) return {};
+
+	const Entry* end = _entries + _count;
+	const Entry* first = std::lower_bound(_entries, end, key, [](const Entry& e, const uint64_t k) { return e.key < k; });
+	const Entry* last = first;
+	// a position rarely has more than a couple dozen moves, walking them beats a second binary search.
+	while (last != end && last->key == key) {
+		last++;
+	}
+	return {first, last};
+}
+
+// Builder
+
+PositionDB::Builder::Builder(const std::string& path, const int maxPly, const size_t bufferEntries)
+	: _path(path), _maxPly(maxPly), _bufferEntries(std::max<size_t>(bufferEntries, 1024)) {
+	_buffer.reserve(_bufferEntries);
+}
+
+PositionDB::Builder::~Builder() {
+	for (const std::string& run : _runs) {
+		std::remove(run.c_str());
+	}
+}
+
+bool PositionDB::Builder::add(const PGN::Game& game) {
+	if (_finished) throw std::runtime_error("PositionDB::Builder used after finish()");
+
+	Entry counts { 0, 0, 0, 0, 0 };
+	if (game.result == "1-0") {
+		counts.white = 1;
+	} else if (game.result == "0-1") {
+		counts.black = 1;
+	} else if (game.result == "1/2-1/2") {
+		counts.draws = 1;
+	} else {
+		return false;
+	}
+
+	GameState state = game.start;
+	const size_t plies = _maxPly > 0 ? std::min<size_t>(_maxPly, game.moves.size()) : game.moves.size();
+	for (size_t i = 0; i < plies; i++) {
+		const Move& move = game.moves[i];
+		counts.key = keyFor(state);
+		counts.move = packMove(move);
+		_buffer.push_back(counts);
+		if (_buffer.size() == _bufferEntries) {
+			spill();
+		}
+		state.MakeMove(move);
+	}
+	return true;
+}
+
+// sorts the buffer, folds duplicate (position, move) pairs together, and writes it out as a run.
+void PositionDB::Builder::spill() {
+	if (_buffer.empty()) return;
+
+	std::sort(_buffer.begin(), _buffer.end(), entryLess);
+	size_t unique = 0;
+	for (size_t i = 1; i < _buffer.size(); i++) {
+		if (sameEntry(_buffer[unique], _buffer[i])) {
+			addCounts(_buffer[unique], _buffer[i]);
+		} else {
+			_buffer[++unique] = _buffer[i];
+		}
+	}
+	_buffer.resize(unique + 1);
+
+	const std::string runPath = _path + ".run" + std::to_string(_runs.size());
+	std::ofstream run(runPath, std::ios::binary | std::ios::trunc);
+	if (!run) throw std::runtime_error("Couldn't create " + runPath);
+	_runs.push_back(runPath);
+	run.write(reinterpret_cast<const char*>(_buffer.data()), _buffer.size() * sizeof(Entry));
+	if (!run) throw std::runtime_error("Couldn't write " + runPath);
+	_buffer.clear();
+}
+
+namespace {
+	// reads a run back a block at a time.
+	struct RunReader {
+		std::ifstream in;
+		std::vector<PositionDB::Entry> block;
+		size_t pos = 0;
+
+		explicit RunReader(const std::string& path) : in(path, std::ios::binary) {
+			if (!in) throw std::runtime_error("Couldn't reopen " + path);
+			block.reserve(1 << 14);
+		}
+
+		bool next(PositionDB::Entry& entry) {
+			if (pos == block.size()) {
+				block.resize(block.capacity());
+				in.read(reinterpret_cast<char*>(block.data()), block.size() * sizeof(PositionDB::Entry));
+				block.resize(in.gcount() / sizeof(PositionDB::Entry));
+				pos = 0;
+				if (block.empty()) return false;
+			}
+			entry = block[pos++];
+			return true;
+		}
+	};
+}
+
+uint64_t PositionDB::Builder::finish() {
+	if (_finished) throw std::runtime_error("PositionDB::Builder::finish() called twice");
+	_finished = true;
+	spill();
+	_buffer = std::vector<Entry>();
+
+	std::ofstream out(_path, std::ios::binary | std::ios::trunc);
+	if (!out) throw std::runtime_error("Couldn't create " + _path);
+
+	Header header {};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.entrySize = sizeof(Entry);
+	// count gets patched in once we know it.
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	std::vector<RunReader> readers;
+	readers.reserve(_runs.size());
+	for (const std::string& run : _runs) {
+		readers.emplace_back(run);
+	}
+
+	// k-way merge. Each run is already sorted & unique, so duplicates can only come from different runs,
+	// and they come out of the queue next to each other.
+	using Head = std::pair<Entry, size_t>;
+	auto later = [](const Head& a, const Head& b) { return entryLess(b.first, a.first); };
+	std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+	for (size_t i = 0; i < readers.size(); i++) {
+		Entry entry;
+		if (readers[i].next(entry)) heads.emplace(entry, i);
+	}
+
+	std::vector<Entry> block;
+	block.reserve(1 << 14);
+	auto emit = [&](const Entry& entry) {
+		if (block.size() == block.capacity()) {
+			out.write(reinterpret_cast<const char*>(block.data()), block.size() * sizeof(Entry));
+			block.clear();
+		}
+		block.push_back(entry);
+		header.count++;
+	};
+
+	bool pending = false;
+	Entry current {};
+	while (!heads.empty()) {
+		const auto [entry, run] = heads.top();
+		heads.pop();
+
+		if (pending && sameEntry(current, entry)) {
+			addCounts(current, entry);
+		} else {
+			if (pending) emit(current);
+			current = entry;
+			pending = true;
+		}
+
+		Entry next;
+		if (readers[run].next(next)) heads.emplace(next, run);
+	}
+	if (pending) emit(current);
+	out.write(reinterpret_cast<const char*>(block.data()), block.size() * sizeof(Entry));
+
+	out.seekp(0);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	if (!out) throw std::runtime_error("Couldn't write " + _path);
+
+	readers.clear();
+	for (const std::string& run : _runs) {
+		std::remove(run.c_str());
+	}
+	_runs.clear();
+	return header.count;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "GameState.h"
+#include "MappedFile.h"
+#include "Move.h"
+#include "PGN.h"
+
+// On disk index of every (position, next move) pair seen in a set of games, with how those games ended.
+// The file is a small header followed by one flat array of entries sorted by key then move, so a lookup is a binary
+// search straight over the mapped file. Nothing gets read into the heap, and opening a huge database is instant.
+//
+// Multi byte fields are in host byte order, same as PackedPosition.
+class PositionDB {
+	public:
+	struct Entry {
+		uint64_t key;   // see keyFor()
+		uint32_t move;  // from | to << 6 | flags << 12, see toMove()
+		uint32_t white; // games won by white after this move was played here
+		uint32_t draws;
+		uint32_t black;
+
+		Move toMove() const { return Move((move >> 6) & squareMask, move & squareMask, move >> 12); }
+		uint32_t games() const { return white + draws + black; }
+	};
+	static_assert(sizeof(Entry) == 24, "PositionDB::Entry is written to disk as is");
+
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t entrySize;
+		uint64_t count;
+	};
+	static const uint32_t VERSION = 1;
+
+	// Zobrist key of the position. The en passant square only counts when a pawn can actually take on it, otherwise
+	// the same position reached with & without a double push would get split in two.
+	static uint64_t keyFor(const GameState& state);
+	static uint32_t packMove(const Move& move);
+
+	// returns false if the file is missing or isn't a position database.
+	bool open(const std::string& path);
+	void close();
+	bool isOpen() const { return _entries != nullptr; }
+
+	// every move played from this position, in move order. Empty if it never came up.
+	std::span<const Entry> find(const uint64_t key) const;
+	std::span<const Entry> find(const GameState& state) const { return find(keyFor(state)); }
+	size_t size() const { return _count; }
+
+	// Replays games and writes out a database. Entries are collected in a fixed size buffer; whenever it fills up it
+	// gets sorted, duplicates merged, and spilled to a temporary run file next to the output. finish() then merges
+	// the runs. Memory stays flat no matter how many games go in.
+	class Builder {
+		public:
+		// maxPly of 0 indexes whole games, otherwise only the first maxPly moves of each game (plenty for an opening book).
+		Builder(const std::string& path, const int maxPly = 0, const size_t bufferEntries = 1 << 22);
+		~Builder();
+
+		Builder(const Builder&) = delete;
+		Builder& operator=(const Builder&) = delete;
+
+		// Games without a result ("*") are skipped, returning false. Games with bad movetext count up to the error.
+		bool add(const PGN::Game& game);
+		// Merges everything into the output file. Returns the number of distinct entries written. Throws on I/O errors.
+		uint64_t finish();
+
+		private:
+		void spill();
+
+		std::string _path;
+		int _maxPly;
+		size_t _bufferEntries;
+		std::vector<Entry> _buffer;
+		std::vector<std::string> _runs;
+		bool _finished = false;
+	};
+
+	private:
+	MappedFile _file;
+	const Entry* _entries = nullptr;
+	size_t _count = 0;
+};
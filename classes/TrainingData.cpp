@@ -0,0 +1,76 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <zlib.h>
+
+#include "TrainingData.h"
+
+struct ChunkHeader {
+	uint32_t positions;
+	uint32_t compressedSize;
+	uint32_t crc;
+};
+
+// Biggest chunk a reader will accept, so a corrupt header can't make us allocate gigabytes.
+const size_t MAX_CHUNK_POSITIONS = 1 << 20;
+
+static uint32_t checksum(const TrainingPosition* positions, const size_t count) {
+	return crc32(0, reinterpret_cast<const Bytef*>(positions), (uInt)(count * sizeof(TrainingPosition)));
+}
+
+TrainingWriter::TrainingWriter(std::ostream& out) : _out(out) {
+	_out.write(TRAINING_MAGIC, sizeof(TRAINING_MAGIC));
+	if (!_out) throw std::runtime_error("Couldn't write training data header");
+}
+
+void TrainingWriter::write(const TrainingPosition* positions, const size_t count) {
+	if (count == 0) return;
+	if (count > MAX_CHUNK_POSITIONS) throw std::runtime_error("Training data chunk is too big");
+
+	const uLong rawSize = count * sizeof(TrainingPosition);
+	uLongf compressedSize = compressBound(rawSize);
+	std::vector<Bytef> compressed(compressedSize);
+	if (compress2(compressed.data(), &compressedSize, reinterpret_cast<const Bytef*>(positions), rawSize,
+		Z_DEFAULT_COMPRESSION) != Z_OK) {
+		throw std::runtime_error("Couldn't compress training data");
+	}
+
+	const ChunkHeader header = { (uint32_t)count, (uint32_t)compressedSize, checksum(positions, count) };
+	std::lock_guard<std::mutex> lock(_mutex);
+	_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	_out.write(reinterpret_cast<const char*>(compressed.data()), compressedSize);
+	if (!_out) throw std::runtime_error("Couldn't write training data");
+}
+
+TrainingReader::TrainingReader(std::istream& in) : _in(in) {
+	char magic[sizeof(TRAINING_MAGIC)];
+	_in.read(magic, sizeof(magic));
+	if (!_in || std::memcmp(magic, TRAINING_MAGIC, sizeof(TRAINING_MAGIC)) != 0) {
+		throw std::runtime_error("Not a compressed training data file");
+	}
+}
+
+bool TrainingReader::next(std::vector<TrainingPosition>& positions) {
+	ChunkHeader header;
+	_in.read(reinterpret_cast<char*>(&header), sizeof(header));
+	// a clean end, or a header cut off by a writer that got killed. Either way there's nothing more to read.
+	if (_in.gcount() != sizeof(header)) return false;
+
+	if (header.positions == 0 || header.positions > MAX_CHUNK_POSITIONS ||
+		header.compressedSize > compressBound(MAX_CHUNK_POSITIONS * sizeof(TrainingPosition))) {
+		throw std::runtime_error("Corrupt training data chunk header");
+	}
+
+	_compressed.resize(header.compressedSize);
+	_in.read(reinterpret_cast<char*>(_compressed.data()), header.compressedSize);
+	if ((size_t)_in.gcount() != header.compressedSize) return false;
+
+	positions.resize(header.positions);
+	uLongf rawSize = header.positions * sizeof(TrainingPosition);
+	if (uncompress(reinterpret_cast<Bytef*>(positions.data()), &rawSize, _compressed.data(), header.compressedSize) != Z_OK ||
+		rawSize != header.positions * sizeof(TrainingPosition) || checksum(positions.data(), header.positions) != header.crc) {
+		throw std::runtime_error("Corrupt training data chunk");
+	}
+	return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "PackedPosition.h"
+
+// A position labelled with how its game ended, for tuning & training. Datasets are flat files of these, nothing else,
+// so they can be memory mapped and indexed directly. Host byte order, same as PackedPosition.
+#pragma pack(push, 1)
+struct TrainingPosition {
+	PackedPosition position;
+	int16_t score;   // search score from white's point of view, 0 if the position was never searched
+	int8_t result;   // from white's point of view: 1 win, 0 draw, -1 loss
+	uint8_t padding;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(TrainingPosition) == 36, "TrainingPosition is written to disk as is");
+
+// Compressed datasets, for when flat files get too big to keep around. The file is a magic string followed by
+// independent zlib compressed chunks of TrainingPositions, each with a small header:
+//   "CHESSTD1" { uint32 positions, uint32 compressed size, uint32 crc32 of the positions, data }...
+// Chunks can be decompressed (or shuffled) one at a time, and a file cut off mid write is still good up to its last
+// complete chunk. Needs zlib, so this half is only built into the tools that use it.
+const size_t TRAINING_CHUNK_POSITIONS = 4096;
+// so tools can tell a compressed file from a flat one without zlib.
+const char TRAINING_MAGIC[8] = {'C', 'H', 'E', 'S', 'S', 'T', 'D', '1'};
+
+class TrainingWriter {
+	public:
+	// writes the magic straight away.
+	explicit TrainingWriter(std::ostream& out);
+
+	// Compresses & writes one chunk. Safe to call from several threads at once, compression happens outside the lock
+	// so only the write itself is serialised. Throws if the stream goes bad.
+	void write(const TrainingPosition* positions, const size_t count);
+
+	private:
+	std::ostream& _out;
+	std::mutex _mutex;
+};
+
+class TrainingReader {
+	public:
+	// Throws if the stream doesn't start with the magic.
+	explicit TrainingReader(std::istream& in);
+
+	// Replaces positions with the next chunk. Returns false at the end of the stream, throws on a corrupt chunk.
+	bool next(std::vector<TrainingPosition>& positions);
+
+	private:
+	std::istream& _in;
+	std::vector<uint8_t> _compressed;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+#include "MagicBitboards/ProtoBoard.h"
+#include "MagicBitboards/BitFunctions.h"
+
+// https://www.chessprogramming.org/Zobrist_Hashing
+// Keys are generated at compile time from a fixed seed, so hashes are stable between runs (and between builds),
+// which matters for anything we write to disk.
+namespace Zobrist {
+	// splitmix64, good enough for hashing and trivially constexpr.
+	constexpr uint64_t nextKey(uint64_t& seed) {
+		uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	struct Keys {
+		uint64_t pieces[12][64];  // indexed like ProtoBoard
+		uint64_t castling[16];    // KQkq
+		uint64_t enPassant[8];    // by file
+		uint64_t side;            // xor'd in when black to move
+	};
+
+	constexpr Keys generateKeys() {
+		Keys keys {};
+		uint64_t seed = 0x1234abcd5678ef90ULL;
+		for (int i = 0; i < 12; i++) {
+			for (int sq = 0; sq < 64; sq++) {
+				keys.pieces[i][sq] = nextKey(seed);
+			}
+		}
+		for (int i = 0; i < 16; i++) {
+			keys.castling[i] = nextKey(seed);
+		}
+		for (int i = 0; i < 8; i++) {
+			keys.enPassant[i] = nextKey(seed);
+		}
+		keys.side = nextKey(seed);
+		return keys;
+	}
+
+	inline constexpr Keys keys = generateKeys();
+
+	// Full recompute. Fine for setting up a position or a one-off lookup, but don't call this every node.
+	inline uint64_t computeKey(const ProtoBoard& board, const bool isBlack, const uint8_t castling, const uint8_t enPassant) {
+		uint64_t key = 0;
+		for (int i = 0; i < 12; i++) {
+			forEachBit([&](uint8_t square) {
+				key ^= keys.pieces[i][square];
+			}, board[i]);
+		}
+
+		key ^= keys.castling[castling & 15];
+		if (enPassant < 64) {
+			key ^= keys.enPassant[enPassant & 7];
+		}
+		if (isBlack) {
+			key ^= keys.side;
+		}
+		return key;
+	}
+
+	// Key of the pawns alone, for the pawn hash. GameState keeps this one up to date incrementally.
+	inline uint64_t computePawnKey(const ProtoBoard& board) {
+		uint64_t key = 0;
+		forEachBit([&](uint8_t square) {
+			key ^= keys.pieces[0][square];
+		}, board[0]);
+		forEachBit([&](uint8_t square) {
+			key ^= keys.pieces[6][square];
+		}, board[6]);
+		return key;
+	}
+}
@@ -0,0 +1,170 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../classes/ChessAI.h"
+#include "../classes/KPKBitbase.h"
+#include "../classes/NNUE.h"
+#include "../classes/PieceSquare.h"
+#include "../classes/PlyStack.h"
+
+// Headless benchmark for the two ways search can keep its state (see classes/PlyStack.h). Build it once as is
+// and once with -DCHESS_COPY_MAKE=OFF, then compare. Perft is the raw make/generate cost, the fixed depth search
+// adds evaluation & pruning on top so it's closer to what the AI actually does.
+//
+// usage: chess_bench [perft depth] [search depth]    (NNUE_PATH=<network> to search with NNUE)
+//        chess_bench eval [depth]
+//            checks PieceSquare::evaluate against the scalar version on every position in the bench positions' trees
+//            (default depth 3), and times both.
+
+struct BenchPosition {
+	const char* name;
+	const char* fen;
+};
+
+static const BenchPosition positions[] = {
+	{ "startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1" },
+	{ "kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1" },
+	{ "middle",   "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP2BPPP/R2QKB1R w KQ - 0 8" },
+	{ "endgame",  "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1" },
+};
+
+const int inf = 999999UL;
+
+static uint64_t perft(PlyStack& stack, const int depth) {
+	std::vector<Move> moves = Chess::MoveGenerator(stack.current());
+	if (depth == 1) return moves.size();
+
+	uint64_t nodes = 0;
+	for (const Move& move : moves) {
+		stack.push(move);
+		nodes += perft(stack, depth - 1);
+		stack.pop(move);
+	}
+	return nodes;
+}
+
+static double secondsSince(const std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void collectBoards(PlyStack& stack, const int depth, std::vector<ProtoBoard>& boards) {
+	boards.push_back(stack.current().getProtoBoard());
+	if (depth == 0) return;
+	for (const Move& move : Chess::MoveGenerator(stack.current())) {
+		stack.push(move);
+		collectBoards(stack, depth - 1, boards);
+		stack.pop(move);
+	}
+}
+
+// nanoseconds per evaluation, best of a few rounds since a single one is at the mercy of whatever else is running.
+template<typename F>
+static double timeEvaluations(const std::vector<ProtoBoard>& boards, F&& evaluate, int64_t& checksum) {
+	const int rounds = 5;
+	const int passes = 10;
+	double best = 0;
+	for (int round = 0; round < rounds; round++) {
+		checksum = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (int pass = 0; pass < passes; pass++) {
+			for (const ProtoBoard& board : boards) {
+				checksum += evaluate(board);
+			}
+		}
+		const double time = secondsSince(start) * 1e9 / ((double)passes * boards.size());
+		if (round == 0 || time < best) best = time;
+	}
+	return best;
+}
+
+static int benchEvaluation(const int depth) {
+#if defined(__AVX2__)
+	std::printf("piece square kernel: AVX2\n");
+#else
+	std::printf("piece square kernel: scalar\n");
+#endif
+
+	std::vector<ProtoBoard> boards;
+	for (const BenchPosition& position : positions) {
+		PlyStack stack(GameState::FromFEN(position.fen));
+		collectBoards(stack, depth, boards);
+	}
+
+	uint64_t mismatches = 0;
+	for (const ProtoBoard& board : boards) {
+		if (PieceSquare::evaluate(board) != PieceSquare::evaluateScalar(board)) mismatches++;
+	}
+
+	int64_t vectorSum, scalarSum;
+	const double vectorTime = timeEvaluations(boards, PieceSquare::evaluate, vectorSum);
+	const double scalarTime = timeEvaluations(boards, PieceSquare::evaluateScalar, scalarSum);
+	std::printf("%zu positions, %llu mismatches\n", boards.size(), (unsigned long long)mismatches);
+	std::printf("kernel %.1f ns, scalar %.1f ns per evaluation\n", vectorTime, scalarTime);
+	return mismatches == 0 && vectorSum == scalarSum ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+	if (argc > 1 && !std::strcmp(argv[1], "eval")) {
+		return benchEvaluation(argc > 2 ? std::atoi(argv[2]) : 3);
+	}
+
+	const int perftDepth  = argc > 1 ? std::atoi(argv[1]) : 5;
+	const int searchDepth = argc > 2 ? std::atoi(argv[2]) : 5;
+
+#ifdef CHESS_COPY_MAKE
+	std::printf("search state: copy-make (%zu byte states)\n", sizeof(GameState));
+#else
+	std::printf("search state: make-unmake (%zu byte states, %zu byte memory)\n", sizeof(GameState), sizeof(GameStateMemory));
+#endif
+
+	KPK::init();
+
+	// set NNUE_PATH to time the searches with a network instead of the hand crafted evaluation.
+	const char* networkPath = std::getenv("NNUE_PATH");
+	if (networkPath && !NNUE::load(networkPath)) {
+		std::fprintf(stderr, "Couldn't load network %s\n", networkPath);
+		return 1;
+	}
+	std::printf("evaluation: %s\n", NNUE::isLoaded() ? "NNUE" : "hand crafted");
+
+	uint64_t totalNodes = 0;
+	double perftSeconds = 0;
+	double searchSeconds = 0;
+	uint64_t pawnHits = 0, pawnProbes = 0;
+	uint64_t evalHits = 0, evalMisses = 0;
+	for (const BenchPosition& position : positions) {
+		const GameState root = GameState::FromFEN(position.fen);
+
+		PlyStack stack(root);
+		auto start = std::chrono::steady_clock::now();
+		const uint64_t nodes = perft(stack, perftDepth);
+		const double perftTime = secondsSince(start);
+
+		ChessAI ai(root);
+		start = std::chrono::steady_clock::now();
+		const int score = ai.negamax(searchDepth, 0, -inf, inf, root.isBlackTurn() ? -1 : 1);
+		const double searchTime = secondsSince(start);
+
+		pawnHits += ai.pawnHash().hits();
+		pawnProbes += ai.pawnHash().probes();
+		evalHits += ai.evalHits();
+		evalMisses += ai.evalMisses();
+		totalNodes += nodes;
+		perftSeconds += perftTime;
+		searchSeconds += searchTime;
+		std::printf("%-9s perft d%d %10llu %8.3fs %12.0f nps | search d%d score %6d %8.3fs\n", position.name, perftDepth,
+			(unsigned long long)nodes, perftTime, nodes / perftTime, searchDepth, score, searchTime);
+	}
+
+	std::printf("perft %.0f nps, search %.3fs\n", totalNodes / perftSeconds, searchSeconds);
+	if (evalHits + evalMisses) {
+		std::printf("eval cache hit rate %.1f%% of %llu evaluations\n", 100.0 * evalHits / (evalHits + evalMisses),
+			(unsigned long long)(evalHits + evalMisses));
+	}
+	if (pawnProbes) {
+		std::printf("pawn hash hit rate %.1f%% of %llu probes\n", 100.0 * pawnHits / pawnProbes, (unsigned long long)pawnProbes);
+	}
+	return 0;
+}
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../classes/ChessAI.h"
+#include "../classes/KPKBitbase.h"
+#include "../classes/MagicBitboards/BitFunctions.h"
+#include "../classes/NNUE.h"
+#include "../classes/TrainingData.h"
+
+// Self-play training data. Every thread plays games against itself from randomised openings at a fixed node count,
+// and keeps each quiet position it searched along with the score. Once the game's over the result gets filled in and
+// the positions go out as compressed chunks (see classes/TrainingData.h).
+//
+// usage: chess_datagen [options] -o <out.tdz>
+//        -n <nodes>      nodes per move, default 5000
+//        -g <games>      stop after this many games, default 1000
+//        -r <plies>      random moves to open each game with, default 8 (one more half the time, so both sides get
+//                        to move first)
+//        -t <threads>    default one per core
+//        -s <seed>       default 1, each thread seeds with seed + its index
+//        chess_datagen unpack <in.tdz> <out.bin>
+//            decompresses to a flat file, for tools (or a chess_tune without zlib) that want to map it.
+// Set NNUE_PATH to a network to play with it.
+
+struct Options {
+	const char* output = nullptr;
+	uint64_t nodes = 5000;
+	int games = 1000;
+	int randomPlies = 8;
+	unsigned threads = 0;
+	uint64_t seed = 1;
+};
+
+// Adjudication, same idea as chess_selfplay.
+const int MAX_GAME_PLIES = 400;
+const int RESIGN_SCORE = 1000;
+const int RESIGN_PLIES = 6;
+const int FIFTY_MOVE_PLIES = 100;
+// openings that come out of the random moves already this lopsided get thrown away.
+const int MAX_OPENING_SCORE = 400;
+// the search only stops on its node limit, this just has to be out of reach.
+const int SEARCH_DEPTH = 64;
+
+static const char* const START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+static bool insufficientMaterial(const GameState& state) {
+	const ProtoBoard& board = state.getProtoBoard();
+	const uint64_t heavyOrPawns = board[0] | board[3] | board[4] | board[6] | board[9] | board[10];
+	if (heavyOrPawns) return false;
+	return popCount(board[1] | board[2] | board[7] | board[8]) <= 1;
+}
+
+class Generator {
+	public:
+	Generator(const Options& options, TrainingWriter& writer) : _options(options), _writer(writer) {}
+
+	void run() {
+		std::vector<std::thread> workers;
+		for (unsigned i = 0; i < _options.threads; i++) {
+			workers.emplace_back(&Generator::work, this, i);
+		}
+
+		// progress, from the main thread so the workers never wait on stdout.
+		const auto start = std::chrono::steady_clock::now();
+		double lastReport = 0;
+		while (_finishedThreads < _options.threads) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (seconds - lastReport >= 10) {
+				lastReport = seconds;
+				report(seconds);
+			}
+		}
+
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+		report(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		if (!_error.empty()) throw std::runtime_error(_error);
+	}
+
+	private:
+	void report(const double seconds) const {
+		std::printf("games %llu  positions %llu  %.0f positions/s\n", (unsigned long long)_games.load(),
+			(unsigned long long)_positions.load(), _positions / seconds);
+		std::fflush(stdout);
+	}
+
+	void work(const unsigned index) {
+		try {
+			generate(index);
+		} catch (const std::exception& e) {
+			// the writer failed, no point anyone carrying on.
+			std::lock_guard<std::mutex> lock(_errorMutex);
+			_error = e.what();
+			_nextGame = _options.games;
+		}
+		_finishedThreads++;
+	}
+
+	void generate(const unsigned index) {
+		std::mt19937_64 rng(_options.seed + index);
+		ChessAI ai(GameState::FromFEN(START_FEN));
+		std::vector<TrainingPosition> game;
+		std::vector<TrainingPosition> chunk;
+		chunk.reserve(TRAINING_CHUNK_POSITIONS);
+
+		while (_nextGame++ < (uint64_t)_options.games) {
+			const int8_t result = playGame(ai, rng, game);
+			for (TrainingPosition& position : game) {
+				position.result = result;
+				chunk.push_back(position);
+				if (chunk.size() == TRAINING_CHUNK_POSITIONS) {
+					_writer.write(chunk.data(), chunk.size());
+					chunk.clear();
+				}
+			}
+			_games++;
+			_positions += game.size();
+		}
+
+		_writer.write(chunk.data(), chunk.size());
+	}
+
+	// Random legal moves from the start position, retried until it lands somewhere playable & roughly level.
+	GameState randomOpening(ChessAI& ai, std::mt19937_64& rng) {
+		while (true) {
+			GameState state = GameState::FromFEN(START_FEN);
+			const int plies = _options.randomPlies + (int)(rng() & 1);
+			bool playable = true;
+			for (int ply = 0; ply < plies && playable; ply++) {
+				const std::vector<Move> legal = Chess::MoveGenerator(state);
+				if (legal.empty()) {
+					playable = false;
+				} else {
+					state.MakeMove(legal[rng() % legal.size()]);
+				}
+			}
+			if (!playable || Chess::MoveGenerator(state).empty()) continue;
+
+			ai.setPosition(state);
+			if (std::abs(ai.search(SEARCH_DEPTH, _options.nodes).score) <= MAX_OPENING_SCORE) return state;
+		}
+	}
+
+	// Plays a game and fills positions with its quiet positions (results still blank). Returns the result for white.
+	int8_t playGame(ChessAI& ai, std::mt19937_64& rng, std::vector<TrainingPosition>& positions) {
+		positions.clear();
+		GameState state = randomOpening(ai, rng);
+		std::vector<uint64_t> history = { state.getKey() };
+		int decisivePlies = 0;
+
+		for (int ply = 0; ply < MAX_GAME_PLIES; ply++) {
+			const std::vector<Move> legal = Chess::MoveGenerator(state);
+			if (legal.empty()) {
+				if (!Chess::InCheck()) return 0;
+				return state.isBlackTurn() ? 1 : -1;
+			}
+			const bool inCheck = Chess::InCheck();
+			if (state.getHalfClock() >= FIFTY_MOVE_PLIES || insufficientMaterial(state)) return 0;
+
+			ai.setPosition(state);
+			const SearchResult result = ai.search(SEARCH_DEPTH, _options.nodes);
+			const Move move = result.pv.empty() ? legal.front() : result.bestMove;
+			const int whiteScore = state.isBlackTurn() ? -result.score : result.score;
+
+			// quiet means the static eval has a chance of agreeing with the search: not in check, not about to capture
+			// or promote, and not already decided.
+			const bool capture = move.isEnCapture() || (state.getEnemyOccuupancyBoard() & (1ULL << move.getTo())) != 0;
+			if (!inCheck && !capture && !move.isPromotion() && std::abs(whiteScore) < RESIGN_SCORE) {
+				TrainingPosition position = {};
+				position.position = PackedPosition::pack(state);
+				position.score = (int16_t)whiteScore;
+				positions.push_back(position);
+			}
+
+			if (whiteScore >= RESIGN_SCORE) {
+				decisivePlies = std::max(decisivePlies, 0) + 1;
+			} else if (whiteScore <= -RESIGN_SCORE) {
+				decisivePlies = std::min(decisivePlies, 0) - 1;
+			} else {
+				decisivePlies = 0;
+			}
+			if (std::abs(decisivePlies) >= RESIGN_PLIES) {
+				return decisivePlies > 0 ? 1 : -1;
+			}
+
+			state.MakeMove(move);
+			if (state.getHalfClock() == 0) {
+				history.clear();
+			}
+			const uint64_t key = state.getKey();
+			if (std::count(history.begin(), history.end(), key) >= 2) return 0;
+			history.push_back(key);
+		}
+		return 0;
+	}
+
+	const Options _options;
+	TrainingWriter& _writer;
+	std::atomic<uint64_t> _nextGame = 0;
+	std::atomic<uint64_t> _games = 0;
+	std::atomic<uint64_t> _positions = 0;
+	std::atomic<unsigned> _finishedThreads = 0;
+	std::mutex _errorMutex;
+	std::string _error;
+};
+
+static int unpack(const char* inPath, const char* outPath) {
+	std::ifstream in(inPath, std::ios::binary);
+	if (!in) throw std::runtime_error(std::string("Couldn't open ") + inPath);
+	std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+	if (!out) throw std::runtime_error(std::string("Couldn't create ") + outPath);
+
+	TrainingReader reader(in);
+	std::vector<TrainingPosition> chunk;
+	uint64_t positions = 0;
+	while (reader.next(chunk)) {
+		out.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(TrainingPosition));
+		positions += chunk.size();
+	}
+	if (!out) throw std::runtime_error(std::string("Couldn't write ") + outPath);
+	std::printf("%llu positions written to %s\n", (unsigned long long)positions, outPath);
+	return 0;
+}
+
+static Options parseOptions(int argc, char** argv) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 >= argc || argv[i][0] != '-') {
+			throw std::runtime_error(std::string("Unexpected argument ") + argv[i]);
+		}
+		const char* value = argv[++i];
+		switch (argv[i - 1][1]) {
+			case 'o': options.output = value; break;
+			case 'n': options.nodes = std::strtoull(value, nullptr, 10); break;
+			case 'g': options.games = std::atoi(value); break;
+			case 'r': options.randomPlies = std::atoi(value); break;
+			case 't': options.threads = (unsigned)std::atoi(value); break;
+			case 's': options.seed = std::strtoull(value, nullptr, 10); break;
+			default: throw std::runtime_error(std::string("Unknown option ") + argv[i - 1]);
+		}
+	}
+
+	if (!options.output) throw std::runtime_error("No output file");
+	if (options.nodes == 0) throw std::runtime_error("Node limit has to be above 0");
+	if (options.threads == 0) {
+		options.threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	return options;
+}
+
+int main(int argc, char** argv) {
+	if (argc == 4 && !std::strcmp(argv[1], "unpack")) {
+		try {
+			return unpack(argv[2], argv[3]);
+		} catch (const std::exception& e) {
+			std::fprintf(stderr, "%s\n", e.what());
+			return 1;
+		}
+	}
+
+	Options options;
+	try {
+		options = parseOptions(argc, argv);
+	} catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\nusage: chess_datagen [-n nodes] [-g games] [-r plies] [-t threads] [-s seed] -o out.tdz\n"
+			"       chess_datagen unpack in.tdz out.bin\n", e.what());
+		return 1;
+	}
+
+	KPK::init();
+	const char* networkPath = std::getenv("NNUE_PATH");
+	if (networkPath && !NNUE::load(networkPath)) {
+		std::fprintf(stderr, "Couldn't load network %s\n", networkPath);
+		return 1;
+	}
+
+	std::ofstream out(options.output, std::ios::binary | std::ios::trunc);
+	if (!out) {
+		std::fprintf(stderr, "Couldn't create %s\n", options.output);
+		return 1;
+	}
+
+	try {
+		TrainingWriter writer(out);
+		Generator generator(options, writer);
+		std::printf("%d games at %llu nodes per move on %u threads\n", options.games, (unsigned long long)options.nodes,
+			options.threads);
+		generator.run();
+	} catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+	return 0;
+}
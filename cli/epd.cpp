@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../classes/ChessAI.h"
+#include "../classes/KPKBitbase.h"
+#include "../classes/NNUE.h"
+
+// Headless batch analysis. Streams an EPD (or FEN) file, searches every position on a pool of worker threads and
+// writes one line back per input line, in the same order:
+//   <position> bm e2e4; ce 35; acd 5; acn 12345; pv "e2e4 e7e5 g1f3";
+// ce is centipawns from the side to move's point of view. Blank lines and # comments are passed through untouched,
+// positions that fail to parse get an error opcode instead.
+//
+// Only a fixed window of lines is ever in flight, so memory stays flat no matter how big the file is.
+//
+// usage: chess_epd [options] <file>    (- or no file reads stdin)
+//        -d <depth>    search depth, default 5
+//        -n <nodes>    stop each search after this many nodes, default no limit
+//        -t <threads>  worker threads, default one per core
+// Set NNUE_PATH to a network to evaluate with it.
+
+struct Options {
+	const char* path = nullptr;
+	int depth = 5;
+	uint64_t nodes = 0;
+	unsigned threads = 0;
+};
+
+struct Slot {
+	std::string line;
+	std::string output;
+	bool done = false;
+};
+
+// Lines in flight live in a ring of slots indexed by line number. The main thread reads lines in & writes results
+// out in order, the workers take whichever line is next to search.
+class EPDBatch {
+	public:
+	EPDBatch(const Options& options, std::ostream& out) : _options(options), _out(out), _window(options.threads * 8) {}
+
+	void run(std::istream& in) {
+		std::vector<std::thread> workers;
+		for (unsigned i = 0; i < _options.threads; i++) {
+			workers.emplace_back(&EPDBatch::work, this);
+		}
+
+		std::string line;
+		while (std::getline(in, line)) {
+			std::unique_lock<std::mutex> lock(_mutex);
+			// window's full, wait for the oldest line to finish so it can be written out & its slot reused.
+			while (_read - _written == _window.size()) {
+				_resultReady.wait(lock, [this] { return slotFor(_written).done; });
+				flush();
+			}
+
+			Slot& slot = slotFor(_read++);
+			slot.line = std::move(line);
+			slot.done = false;
+			_workAvailable.notify_one();
+			flush();
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_finished = true;
+			_workAvailable.notify_all();
+			while (_written < _read) {
+				_resultReady.wait(lock, [this] { return slotFor(_written).done; });
+				flush();
+			}
+		}
+
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	private:
+	Slot& slotFor(const uint64_t index) { return _window[index % _window.size()]; }
+
+	// writes out every finished line at the front of the window. Called with the lock held.
+	void flush() {
+		while (_written < _read && slotFor(_written).done) {
+			Slot& slot = slotFor(_written++);
+			_out << slot.output << '\n';
+		}
+	}
+
+	void work() {
+		// each worker keeps one searcher around, so the per ply state is only allocated once.
+		// It gets a real position before every search, the bare kings are just something to construct it with.
+		ChessAI ai(GameState::FromFEN("4k3/8/8/8/8/8/8/4K3 w - - 0 1"));
+
+		while (true) {
+			uint64_t index;
+			std::string line;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_workAvailable.wait(lock, [this] { return _next < _read || _finished; });
+				if (_next == _read) return;
+				index = _next++;
+				line = slotFor(index).line;
+			}
+
+			std::string output = analyse(ai, line);
+
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				Slot& slot = slotFor(index);
+				slot.output = std::move(output);
+				slot.done = true;
+			}
+			_resultReady.notify_one();
+		}
+	}
+
+	std::string analyse(ChessAI& ai, const std::string& line) {
+		const size_t start = line.find_first_not_of(" \t\r");
+		if (start == std::string::npos || line[start] == '#') return line;
+
+		// the position is the first four fields, everything after is EPD operations (or FEN clocks) we don't need.
+		size_t end = start;
+		for (int field = 0; field < 4 && end != std::string::npos; field++) {
+			end = line.find_first_not_of(' ', end);
+			if (end != std::string::npos) end = line.find(' ', end);
+		}
+		const std::string position = line.substr(start, end == std::string::npos ? std::string::npos : end - start);
+
+		try {
+			ai.setPosition(GameState::FromFEN(line));
+		} catch (const std::exception& e) {
+			return position + " error \"" + e.what() + "\";";
+		}
+
+		const SearchResult result = ai.search(_options.depth, _options.nodes);
+
+		std::string output = position;
+		output += " bm " + (result.pv.empty() ? std::string("none") : result.bestMove.toUCI()) + ";";
+		output += " ce " + std::to_string(result.score) + ";";
+		output += " acd " + std::to_string(result.depth) + ";";
+		output += " acn " + std::to_string(result.nodes) + ";";
+		output += " pv \"";
+		for (size_t i = 0; i < result.pv.size(); i++) {
+			if (i) output += ' ';
+			output += result.pv[i].toUCI();
+		}
+		output += "\";";
+		return output;
+	}
+
+	const Options _options;
+	std::ostream& _out;
+	std::vector<Slot> _window;
+
+	std::mutex _mutex;
+	std::condition_variable _workAvailable;
+	std::condition_variable _resultReady;
+	uint64_t _read = 0;    // lines read so far
+	uint64_t _next = 0;    // next line a worker should pick up
+	uint64_t _written = 0; // lines written so far
+	bool _finished = false;
+};
+
+static Options parseOptions(int argc, char** argv) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		const bool hasValue = i + 1 < argc;
+		if (!std::strcmp(argv[i], "-d") && hasValue) {
+			options.depth = std::atoi(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-n") && hasValue) {
+			options.nodes = std::strtoull(argv[++i], nullptr, 10);
+		} else if (!std::strcmp(argv[i], "-t") && hasValue) {
+			options.threads = (unsigned)std::atoi(argv[++i]);
+		} else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+			throw std::runtime_error(std::string("Unknown option ") + argv[i]);
+		} else {
+			options.path = argv[i];
+		}
+	}
+
+	if (options.depth < 1 || options.depth >= MAX_PLY) {
+		throw std::runtime_error("Depth must be between 1 and " + std::to_string(MAX_PLY - 1));
+	}
+	if (options.threads == 0) {
+		options.threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	return options;
+}
+
+int main(int argc, char** argv) {
+	Options options;
+	try {
+		options = parseOptions(argc, argv);
+	} catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\nusage: chess_epd [-d depth] [-n nodes] [-t threads] [file]\n", e.what());
+		return 1;
+	}
+
+	// shared, read only tables have to be ready before any worker starts.
+	KPK::init();
+	const char* networkPath = std::getenv("NNUE_PATH");
+	if (networkPath && !NNUE::load(networkPath)) {
+		std::fprintf(stderr, "Couldn't load network %s\n", networkPath);
+		return 1;
+	}
+
+	std::ios::sync_with_stdio(false);
+	EPDBatch batch(options, std::cout);
+	if (!options.path || !std::strcmp(options.path, "-")) {
+		batch.run(std::cin);
+		return 0;
+	}
+
+	std::ifstream file(options.path);
+	if (!file) {
+		std::fprintf(stderr, "Couldn't open %s\n", options.path);
+		return 1;
+	}
+	batch.run(file);
+	return 0;
+}
@@ -0,0 +1,146 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "../classes/Chess.h"
+#include "../classes/PlyStack.h"
+#include "../classes/PositionBatch.h"
+
+// Headless perft, counts leaf nodes of the legal move tree and checks them against known results.
+// Run it after touching move generation or the slider lookups (ex. once with -DCHESS_USE_PEXT=ON and once without),
+// any difference in node counts means the two backends disagree.
+//
+// usage: chess_perft                 runs the suite below
+//        chess_perft -b              runs the suite, counting the last ply with PositionBatch instead
+//        chess_perft <depth> <fen>   counts a single position, printing the count for each root move
+
+// https://www.chessprogramming.org/Perft_Results
+struct PerftCase {
+	const char* name;
+	const char* fen;
+	int depth;
+	uint64_t nodes;
+};
+
+static const PerftCase suite[] = {
+	{ "startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",             5, 4865609 },
+	{ "kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603 },
+	{ "pos3",     "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",                            5, 674624 },
+	{ "pos4",     "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",     4, 422333 },
+	{ "pos5",     "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",            4, 2103487 },
+};
+
+static uint64_t perft(PlyStack& stack, const int depth) {
+	std::vector<Move> moves = Chess::MoveGenerator(stack.current());
+	if (depth == 1) return moves.size();
+
+	uint64_t nodes = 0;
+	for (const Move& move : moves) {
+		stack.push(move);
+		nodes += perft(stack, depth - 1);
+		stack.pop(move);
+	}
+	return nodes;
+}
+
+// Queues up the positions on the last ply & counts their moves a batch at a time.
+struct BatchedCounter {
+	static const size_t BATCH_SIZE = 256;
+
+	PositionBatch batch;
+	uint32_t counts[BATCH_SIZE];
+	uint64_t nodes = 0;
+
+	void add(const GameState& state) {
+		batch.add(state);
+		if (batch.size() == BATCH_SIZE) flush();
+	}
+
+	void flush() {
+		batch.countMoves(counts);
+		for (size_t i = 0; i < batch.size(); i++) {
+			nodes += counts[i];
+		}
+		batch.clear();
+	}
+};
+
+static void perftBatched(PlyStack& stack, const int depth, BatchedCounter& counter) {
+	if (depth == 1) {
+		counter.add(stack.current());
+		return;
+	}
+
+	for (const Move& move : Chess::MoveGenerator(stack.current())) {
+		stack.push(move);
+		perftBatched(stack, depth - 1, counter);
+		stack.pop(move);
+	}
+}
+
+static int divide(const std::string& fen, const int depth) {
+	PlyStack stack(GameState::FromFEN(fen));
+	uint64_t total = 0;
+	for (const Move& move : Chess::MoveGenerator(stack.current())) {
+		stack.push(move);
+		const uint64_t nodes = depth > 1 ? perft(stack, depth - 1) : 1;
+		stack.pop(move);
+
+		std::printf("%s: %llu\n", move.toUCI().c_str(), (unsigned long long)nodes);
+		total += nodes;
+	}
+	std::printf("\nnodes: %llu\n", (unsigned long long)total);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if (argc >= 3) {
+		return divide(argv[2], std::atoi(argv[1]));
+	}
+	const bool batched = argc == 2 && std::string(argv[1]) == "-b";
+
+#ifdef CHESS_USE_PEXT
+	std::printf("slider lookups: pext\n");
+#else
+	std::printf("slider lookups: magic\n");
+#endif
+#ifdef CHESS_COPY_MAKE
+	std::printf("search state: copy-make\n");
+#else
+	std::printf("search state: make-unmake\n");
+#endif
+	if (batched) {
+		std::printf("last ply: batched, %zu lanes\n", PositionBatch::BATCH_LANES);
+	}
+
+	int failures = 0;
+	uint64_t totalNodes = 0;
+	double totalSeconds = 0;
+	for (const PerftCase& test : suite) {
+		PlyStack stack(GameState::FromFEN(test.fen));
+
+		const auto start = std::chrono::steady_clock::now();
+		uint64_t nodes;
+		if (batched) {
+			BatchedCounter counter;
+			perftBatched(stack, test.depth, counter);
+			counter.flush();
+			nodes = counter.nodes;
+		} else {
+			nodes = perft(stack, test.depth);
+		}
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		totalNodes += nodes;
+		totalSeconds += seconds;
+
+		const bool ok = nodes == test.nodes;
+		if (!ok) failures++;
+		std::printf("%-9s d%d %10llu (expected %10llu) %8.3fs %12.0f nps %s\n", test.name, test.depth, (unsigned long long)nodes,
+			(unsigned long long)test.nodes, seconds, nodes / seconds, ok ? "ok" : "MISMATCH");
+	}
+
+	std::printf("total %llu nodes in %.3fs, %.0f nps\n", (unsigned long long)totalNodes, totalSeconds, totalNodes / totalSeconds);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "../classes/PGN.h"
+
+// Reads a PGN file through PGN::Reader, checking every move is legal, and reports how fast it went.
+// With -o it also writes every game back out in export format, which doubles as a round trip test of the writer.
+//
+// usage: chess_pgn [-o out.pgn] <file>   (- or no file reads stdin)
+
+int main(int argc, char** argv) {
+	const char* inPath = nullptr;
+	const char* outPath = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if (!std::strcmp(argv[i], "-o") && i + 1 < argc) {
+			outPath = argv[++i];
+		} else {
+			inPath = argv[i];
+		}
+	}
+
+	std::ifstream file;
+	if (inPath && std::strcmp(inPath, "-")) {
+		file.open(inPath, std::ios::binary);
+		if (!file) {
+			std::fprintf(stderr, "Couldn't open %s\n", inPath);
+			return 1;
+		}
+	}
+	std::istream& in = file.is_open() ? file : std::cin;
+
+	double megabytes = 0;
+	if (file.is_open()) {
+		file.seekg(0, std::ios::end);
+		megabytes = (double)file.tellg() / (1 << 20);
+		file.seekg(0, std::ios::beg);
+	}
+
+	std::ofstream out;
+	if (outPath) {
+		out.open(outPath);
+		if (!out) {
+			std::fprintf(stderr, "Couldn't open %s\n", outPath);
+			return 1;
+		}
+	}
+
+	PGN::Reader reader(in);
+	PGN::Game game;
+	uint64_t games = 0, plies = 0, errors = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	while (reader.next(game)) {
+		games++;
+		plies += game.moves.size();
+		if (!game.error.empty()) {
+			errors++;
+			std::fprintf(stderr, "game %llu: %s\n", (unsigned long long)games, game.error.c_str());
+		}
+		if (out.is_open()) {
+			PGN::write(out, game);
+		}
+	}
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::printf("%llu games, %llu plies, %llu with errors in %.3fs (%.0f games/s", (unsigned long long)games,
+		(unsigned long long)plies, (unsigned long long)errors, seconds, games / seconds);
+	if (megabytes > 0) std::printf(", %.1f MB/s", megabytes / seconds);
+	std::printf(")\n");
+	return errors == 0 ? 0 : 1;
+}
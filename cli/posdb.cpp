@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../classes/PositionDB.h"
+
+// Builds & queries the position database (see classes/PositionDB.h).
+//
+// usage: chess_posdb build [-p plies] [-m entries] -o <out.db> <file.pgn>...   (- reads stdin)
+//            -p <plies>    only index the first plies moves of every game, default whole games
+//            -m <entries>  entries buffered in memory before spilling a run to disk, default 4M (~96MB)
+//        chess_posdb query <file.db> [fen]    default is the starting position
+
+static int usage() {
+	std::fprintf(stderr, "usage: chess_posdb build [-p plies] [-m entries] -o out.db file.pgn...\n"
+		"       chess_posdb query file.db [fen]\n");
+	return 1;
+}
+
+static int build(int argc, char** argv) {
+	const char* outPath = nullptr;
+	int maxPly = 0;
+	size_t bufferEntries = 1 << 22;
+	std::vector<const char*> inputs;
+	for (int i = 2; i < argc; i++) {
+		const bool hasValue = i + 1 < argc;
+		if (!std::strcmp(argv[i], "-o") && hasValue) {
+			outPath = argv[++i];
+		} else if (!std::strcmp(argv[i], "-p") && hasValue) {
+			maxPly = std::atoi(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-m") && hasValue) {
+			bufferEntries = std::strtoull(argv[++i], nullptr, 10);
+		} else {
+			inputs.push_back(argv[i]);
+		}
+	}
+	if (!outPath || inputs.empty()) return usage();
+
+	const auto start = std::chrono::steady_clock::now();
+	PositionDB::Builder builder(outPath, maxPly, bufferEntries);
+	uint64_t games = 0, skipped = 0;
+
+	PGN::Game game;
+	for (const char* path : inputs) {
+		std::ifstream file;
+		if (std::strcmp(path, "-")) {
+			file.open(path, std::ios::binary);
+			if (!file) {
+				std::fprintf(stderr, "Couldn't open %s\n", path);
+				return 1;
+			}
+		}
+
+		PGN::Reader reader(file.is_open() ? file : std::cin);
+		while (reader.next(game)) {
+			if (builder.add(game)) {
+				games++;
+			} else {
+				skipped++;
+			}
+		}
+	}
+
+	const uint64_t entries = builder.finish();
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::printf("%llu games indexed (%llu skipped without a result), %llu entries written to %s in %.3fs\n",
+		(unsigned long long)games, (unsigned long long)skipped, (unsigned long long)entries, outPath, seconds);
+	return 0;
+}
+
+static int query(int argc, char** argv) {
+	if (argc < 3) return usage();
+
+	PositionDB db;
+	if (!db.open(argv[2])) {
+		std::fprintf(stderr, "%s isn't a position database\n", argv[2]);
+		return 1;
+	}
+
+	std::string fen = PGN::START_FEN;
+	if (argc > 3) {
+		fen.clear();
+		for (int i = 3; i < argc; i++) {
+			if (i > 3) fen += ' ';
+			fen += argv[i];
+		}
+	}
+
+	// a bad FEN throws, which main reports.
+	const GameState state = GameState::FromFEN(fen);
+
+	const auto start = std::chrono::steady_clock::now();
+	const std::span<const PositionDB::Entry> moves = db.find(state);
+	const double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+	std::printf("%zu moves from %zu entries, lookup took %.1fus\n", moves.size(), db.size(), micros);
+	std::printf("%-8s %10s %7s %7s %7s\n", "move", "games", "white", "draw", "black");
+	for (const PositionDB::Entry& entry : moves) {
+		const double games = entry.games();
+		std::printf("%-8s %10u %6.1f%% %6.1f%% %6.1f%%\n", PGN::toSAN(state, entry.toMove()).c_str(), entry.games(),
+			100 * entry.white / games, 100 * entry.draws / games, 100 * entry.black / games);
+	}
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) return usage();
+
+	try {
+		if (!std::strcmp(argv[1], "build")) return build(argc, argv);
+		if (!std::strcmp(argv[1], "query")) return query(argc, argv);
+	} catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+	return usage();
+}
@@ -0,0 +1,413 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../classes/ChessAI.h"
+#include "../classes/KPKBitbase.h"
+#include "../classes/MagicBitboards/BitFunctions.h"
+#include "../classes/PGN.h"
+
+// Plays engine A against engine B until an SPRT decides which hypothesis holds (or the game limit runs out),
+// so we can tell whether a change actually made the engine stronger. Every game slot runs on its own thread with its
+// own searchers. Each opening gets played twice with colours swapped, which cancels out most opening bias.
+// Both engines are deterministic, so every pair also starts with a few seeded random moves after its opening; without
+// them the pairs would start repeating once the openings ran out, and the repeats would count as new games.
+//
+// Engines only differ by search depth & node limit for now, since the evaluation has nothing tunable yet.
+//
+// usage: chess_selfplay [options]
+//        -a <depth>[,<nodes>]   engine A, default 4
+//        -b <depth>[,<nodes>]   engine B, default 3
+//        -o <file>              EPD/FEN openings, one per line. Defaults to a few built in ones
+//        -g <games>             stop after this many games if SPRT hasn't, default 10000
+//        -r <plies>             random moves after each opening, default 4. With 0 there are only 2 games per opening
+//        -s <seed>              default 1, pair n's random moves are seeded with seed + n
+//        -c <threads>           games played at once, default one per core
+//        -e <elo0>,<elo1>       SPRT hypotheses for A's Elo advantage, default 0,10
+//        -p <alpha>,<beta>      SPRT error rates, default 0.05,0.05
+//        -w <file>              write every game to this PGN file
+
+struct EngineConfig {
+	int depth;
+	uint64_t nodes;
+};
+
+struct Options {
+	EngineConfig a = { 4, 0 };
+	EngineConfig b = { 3, 0 };
+	const char* openings = nullptr;
+	int games = 10000;
+	int randomPlies = 4;
+	uint64_t seed = 1;
+	unsigned threads = 0;
+	double elo0 = 0;
+	double elo1 = 10;
+	double alpha = 0.05;
+	double beta = 0.05;
+	const char* pgn = nullptr;
+};
+
+// Adjudication. Games get cut short once the result is obvious or going nowhere.
+const int MAX_GAME_PLIES = 400;
+const int RESIGN_SCORE = 1000;  // both engines have to agree someone's this far ahead...
+const int RESIGN_PLIES = 6;     // ...for this many plies in a row.
+const int FIFTY_MOVE_PLIES = 100;
+// random moves that leave one side already this far ahead (by engine A's search) get rerolled.
+const int MAX_OPENING_SCORE = 400;
+const int OPENING_CHECK_DEPTH = 2;
+// after this many rerolls the opening gets played as given.
+const int MAX_OPENING_ATTEMPTS = 100;
+
+static const char* defaultOpenings[] = {
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2",
+	"rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2",
+	"rnbqkbnr/ppp1pppp/8/3p4/3P4/8/PPP1PPPP/RNBQKBNR w KQkq - 0 2",
+	"rnbqkb1r/pppppppp/5n2/8/2P5/8/PP1PPPPP/RNBQKBNR w KQkq - 1 2",
+	"rnbqkbnr/pppp1ppp/4p3/8/3PP3/8/PPP2PPP/RNBQKBNR b KQkq - 0 2",
+	"rnbqkbnr/pp1ppppp/2p5/8/3PP3/8/PPP2PPP/RNBQKBNR b KQkq - 0 2",
+	"r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3",
+};
+
+enum GameResult { WhiteWins, BlackWins, Draw };
+
+// K vs K, or K + one minor vs K. Nothing else is a forced draw often enough to bother with.
+static bool insufficientMaterial(const GameState& state) {
+	const ProtoBoard& board = state.getProtoBoard();
+	const uint64_t heavyOrPawns = board[0] | board[3] | board[4] | board[6] | board[9] | board[10];
+	if (heavyOrPawns) return false;
+	return popCount(board[1] | board[2] | board[7] | board[8]) <= 1;
+}
+
+// Plays one game from the opening, white & black being whichever engines were passed in. The moves played end up in moves.
+static GameResult playGame(const GameState& opening, ChessAI& white, const EngineConfig& whiteConfig,
+	ChessAI& black, const EngineConfig& blackConfig, std::vector<Move>& moves) {
+	GameState state = opening;
+	moves.clear();
+	// keys since the last irreversible move, for spotting repetitions.
+	std::vector<uint64_t> history = { state.getKey() };
+	int decisivePlies = 0;
+
+	for (int ply = 0; ply < MAX_GAME_PLIES; ply++) {
+		const std::vector<Move> legal = Chess::MoveGenerator(state);
+		if (legal.empty()) {
+			if (!Chess::InCheck()) return Draw;
+			return state.isBlackTurn() ? WhiteWins : BlackWins;
+		}
+		if (state.getHalfClock() >= FIFTY_MOVE_PLIES || insufficientMaterial(state)) return Draw;
+
+		const bool blackToMove = state.isBlackTurn();
+		ChessAI& engine = blackToMove ? black : white;
+		const EngineConfig& config = blackToMove ? blackConfig : whiteConfig;
+		engine.setPosition(state);
+		const SearchResult result = engine.search(config.depth, config.nodes);
+		const Move move = result.pv.empty() ? legal.front() : result.bestMove;
+
+		// resign once both sides have agreed on the winner for long enough.
+		const int whiteScore = blackToMove ? -result.score : result.score;
+		// positive counts plies white's been winning, negative black.
+		if (whiteScore >= RESIGN_SCORE) {
+			decisivePlies = std::max(decisivePlies, 0) + 1;
+		} else if (whiteScore <= -RESIGN_SCORE) {
+			decisivePlies = std::min(decisivePlies, 0) - 1;
+		} else {
+			decisivePlies = 0;
+		}
+		if (std::abs(decisivePlies) >= RESIGN_PLIES) {
+			return decisivePlies > 0 ? WhiteWins : BlackWins;
+		}
+
+		state.MakeMove(move);
+		moves.push_back(move);
+		if (state.getHalfClock() == 0) {
+			history.clear();
+		}
+
+		const uint64_t key = state.getKey();
+		if (std::count(history.begin(), history.end(), key) >= 2) return Draw;
+		history.push_back(key);
+	}
+
+	return Draw;
+}
+
+// Random legal moves on top of the opening, rerolled until it lands somewhere playable & roughly level.
+// Only depends on the seed, so both games of a pair start from the same position.
+static GameState randomiseOpening(const GameState& opening, const int plies, const uint64_t seed, ChessAI& ai) {
+	if (plies == 0) return opening;
+
+	std::mt19937_64 rng(seed);
+	for (int attempt = 0; attempt < MAX_OPENING_ATTEMPTS; attempt++) {
+		GameState state = opening;
+		bool playable = true;
+		for (int ply = 0; ply < plies && playable; ply++) {
+			const std::vector<Move> legal = Chess::MoveGenerator(state);
+			if (legal.empty()) {
+				playable = false;
+			} else {
+				state.MakeMove(legal[rng() % legal.size()]);
+			}
+		}
+		if (!playable || Chess::MoveGenerator(state).empty()) continue;
+
+		ai.setPosition(state);
+		if (std::abs(ai.search(OPENING_CHECK_DEPTH).score) <= MAX_OPENING_SCORE) return state;
+	}
+
+	// a lopsided opening (ex. a queen up) stays lopsided whatever gets played, so rerolling forever would hang.
+	char fen[GameState::MAX_FEN_LENGTH];
+	GameState::ToFEN(opening, fen);
+	std::fprintf(stderr, "warning: no random moves kept %s level or playable after %d tries, playing it without them\n",
+		fen, MAX_OPENING_ATTEMPTS);
+	return opening;
+}
+
+// Results are from engine A's point of view.
+struct Tally {
+	int wins = 0;
+	int draws = 0;
+	int losses = 0;
+
+	int games() const { return wins + draws + losses; }
+	double score() const { return (wins + draws * 0.5) / games(); }
+	// per game variance of the score.
+	double variance() const {
+		const double s = score();
+		return (wins * (1 - s) * (1 - s) + draws * (0.5 - s) * (0.5 - s) + losses * s * s) / games();
+	}
+};
+
+static double eloFromScore(const double score) {
+	const double clamped = std::clamp(score, 1e-6, 1 - 1e-6);
+	return -400.0 * std::log10(1.0 / clamped - 1.0);
+}
+
+static double scoreFromElo(const double elo) {
+	return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+// https://www.chessprogramming.org/Match_Statistics
+// Log likelihood ratio of elo1 over elo0, using the normal approximation to the trinomial (same as fishtest's).
+static double sprtLLR(const Tally& tally, const double elo0, const double elo1) {
+	const double variance = tally.variance();
+	if (tally.games() == 0 || variance <= 0) return 0;
+
+	const double s0 = scoreFromElo(elo0);
+	const double s1 = scoreFromElo(elo1);
+	return tally.games() * (s1 - s0) * (2 * tally.score() - s0 - s1) / (2 * variance);
+}
+
+static void report(const Tally& tally, const Options& options, const double llr, const double lower, const double upper) {
+	const double s = tally.score();
+	const double margin = 1.96 * std::sqrt(tally.variance() / tally.games());
+	const double elo = eloFromScore(s);
+	const double eloLow = eloFromScore(s - margin);
+	const double eloHigh = eloFromScore(s + margin);
+
+	std::printf("games %5d  +%d =%d -%d  elo %+7.1f +/- %5.1f  LLR %+6.2f [%+.2f, %+.2f]\n", tally.games(), tally.wins,
+		tally.draws, tally.losses, elo, (eloHigh - eloLow) / 2, llr, lower, upper);
+	std::fflush(stdout);
+}
+
+static std::string engineName(const char* name, const EngineConfig& config) {
+	std::string text = std::string(name) + " depth " + std::to_string(config.depth);
+	if (config.nodes) text += " nodes " + std::to_string(config.nodes);
+	return text;
+}
+
+static void writeGame(std::ostream& out, const int game, const GameState& opening, const std::vector<Move>& moves,
+	const GameResult result, const bool aIsWhite, const Options& options) {
+	PGN::Game record;
+	record.setTag("Event", "chess_selfplay");
+	record.setTag("Round", std::to_string(game + 1));
+	record.setTag("White", aIsWhite ? engineName("A", options.a) : engineName("B", options.b));
+	record.setTag("Black", aIsWhite ? engineName("B", options.b) : engineName("A", options.a));
+	record.start = opening;
+	record.moves = moves;
+	record.result = result == WhiteWins ? "1-0" : result == BlackWins ? "0-1" : "1/2-1/2";
+	PGN::write(out, record);
+}
+
+static std::vector<GameState> loadOpenings(const char* path) {
+	std::vector<GameState> openings;
+	if (!path) {
+		for (const char* fen : defaultOpenings) {
+			openings.push_back(GameState::FromFEN(fen));
+		}
+		return openings;
+	}
+
+	std::ifstream file(path);
+	if (!file) throw std::runtime_error(std::string("Couldn't open ") + path);
+
+	std::string line;
+	while (std::getline(file, line)) {
+		const size_t start = line.find_first_not_of(" \t\r");
+		if (start == std::string::npos || line[start] == '#') continue;
+		openings.push_back(GameState::FromFEN(line));
+	}
+	if (openings.empty()) throw std::runtime_error(std::string("No openings in ") + path);
+	return openings;
+}
+
+static EngineConfig parseEngine(const char* text) {
+	EngineConfig config = { std::atoi(text), 0 };
+	if (const char* comma = std::strchr(text, ',')) {
+		config.nodes = std::strtoull(comma + 1, nullptr, 10);
+	}
+	if (config.depth < 1 || config.depth >= MAX_PLY) {
+		throw std::runtime_error(std::string("Bad engine depth: ") + text);
+	}
+	return config;
+}
+
+static void parsePair(const char* text, double& first, double& second) {
+	const char* comma = std::strchr(text, ',');
+	if (!comma) throw std::runtime_error(std::string("Expected two comma separated values: ") + text);
+	first = std::atof(text);
+	second = std::atof(comma + 1);
+}
+
+static Options parseOptions(int argc, char** argv) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 >= argc || argv[i][0] != '-') {
+			throw std::runtime_error(std::string("Unexpected argument ") + argv[i]);
+		}
+		const char* value = argv[++i];
+		switch (argv[i - 1][1]) {
+			case 'a': options.a = parseEngine(value); break;
+			case 'b': options.b = parseEngine(value); break;
+			case 'o': options.openings = value; break;
+			case 'g': options.games = std::atoi(value); break;
+			case 'r': options.randomPlies = std::atoi(value); break;
+			case 's': options.seed = std::strtoull(value, nullptr, 10); break;
+			case 'c': options.threads = (unsigned)std::atoi(value); break;
+			case 'e': parsePair(value, options.elo0, options.elo1); break;
+			case 'p': parsePair(value, options.alpha, options.beta); break;
+			case 'w': options.pgn = value; break;
+			default: throw std::runtime_error(std::string("Unknown option ") + argv[i - 1]);
+		}
+	}
+
+	if (options.randomPlies < 0) {
+		throw std::runtime_error("Random plies can't be negative");
+	}
+	if (options.threads == 0) {
+		options.threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	return options;
+}
+
+int main(int argc, char** argv) {
+	Options options;
+	std::vector<GameState> openings;
+	try {
+		options = parseOptions(argc, argv);
+		openings = loadOpenings(options.openings);
+	} catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\nusage: chess_selfplay [-a depth[,nodes]] [-b depth[,nodes]] [-o openings] [-g games] "
+			"[-r plies] [-s seed] [-c threads] [-e elo0,elo1] [-p alpha,beta] [-w games.pgn]\n", e.what());
+		return 1;
+	}
+
+	KPK::init();
+
+	// without random moves, anything past 2 games per opening is a replay.
+	if (options.randomPlies == 0 && options.games > (int)openings.size() * 2) {
+		options.games = (int)openings.size() * 2;
+		std::printf("no random plies, only playing %d games (2 per opening)\n", options.games);
+	}
+
+	const double lower = std::log(options.beta / (1 - options.alpha));
+	const double upper = std::log((1 - options.beta) / options.alpha);
+	std::printf("A: depth %d nodes %llu, B: depth %d nodes %llu, %zu openings + %d random plies (seed %llu), %u threads, "
+		"SPRT elo0 %g elo1 %g\n", options.a.depth, (unsigned long long)options.a.nodes, options.b.depth,
+		(unsigned long long)options.b.nodes, openings.size(), options.randomPlies, (unsigned long long)options.seed,
+		options.threads, options.elo0, options.elo1);
+
+	std::ofstream pgn;
+	if (options.pgn) {
+		pgn.open(options.pgn);
+		if (!pgn) {
+			std::fprintf(stderr, "Couldn't open %s\n", options.pgn);
+			return 1;
+		}
+	}
+
+	std::mutex mutex;
+	Tally tally;
+	std::atomic<int> nextGame = 0;
+	std::atomic<bool> stop = false;
+	double llr = 0;
+
+	auto worker = [&]() {
+		ChessAI a(openings.front());
+		ChessAI b(openings.front());
+		std::vector<Move> moves;
+
+		while (!stop) {
+			const int game = nextGame++;
+			if (game >= options.games) return;
+
+			// every opening twice in a row, A playing white first then black.
+			const int pair = game / 2;
+			const GameState opening = randomiseOpening(openings[pair % openings.size()], options.randomPlies,
+				options.seed + pair, a);
+			const bool aIsWhite = (game & 1) == 0;
+			const GameResult result = aIsWhite ? playGame(opening, a, options.a, b, options.b, moves)
+				: playGame(opening, b, options.b, a, options.a, moves);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (stop) return;
+			if (pgn.is_open()) {
+				writeGame(pgn, game, opening, moves, result, aIsWhite, options);
+			}
+			if (result == Draw) {
+				tally.draws++;
+			} else if ((result == WhiteWins) == aIsWhite) {
+				tally.wins++;
+			} else {
+				tally.losses++;
+			}
+
+			llr = sprtLLR(tally, options.elo0, options.elo1);
+			if (llr <= lower || llr >= upper) {
+				stop = true;
+			}
+			if (stop || tally.games() % 10 == 0) {
+				report(tally, options, llr, lower, upper);
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned i = 0; i < options.threads; i++) {
+		threads.emplace_back(worker);
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	if (tally.games() % 10 != 0 && !stop && tally.games() > 0) {
+		report(tally, options, llr, lower, upper);
+	}
+	if (llr >= upper) {
+		std::printf("H1 accepted: A is stronger by at least %g elo\n", options.elo1);
+	} else if (llr <= lower) {
+		std::printf("H0 accepted: A is no more than %g elo stronger\n", options.elo0);
+	} else {
+		std::printf("inconclusive after %d games\n", tally.games());
+	}
+	return 0;
+}
@@ -0,0 +1,568 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../classes/Chess.h"
+#include "../classes/MappedFile.h"
+#include "../classes/PGN.h"
+#include "../classes/PawnStructure.h"
+#include "../classes/PieceActivity.h"
+#include "../classes/TrainingData.h"
+#include "../classes/MagicBitboards/BitFunctions.h"
+#include "../classes/MagicBitboards/EvaluationTables.h"
+
+// Texel's tuning method. https://www.chessprogramming.org/Texel%27s_Tuning_Method
+// The evaluation's material & piece square tables are fit to game results: a sigmoid of the eval is treated as the
+// expected score, and the mean squared error against how each game actually ended is minimised with gradient descent.
+// The eval is linear in its parameters, so the gradient is exact and each epoch is one pass over the data, split
+// across threads.
+//
+// usage: chess_tune pack [-s plies] -o <data.bin> <file.pgn|file.epd>...
+//            turns games (every quiet position after the first plies moves, default 8) or EPD positions labelled with
+//            c9 "1-0" / [1.0] style results into a dataset of TrainingPositions.
+//        chess_tune tune [options] <data.bin|data.tdz>
+//            flat datasets are memory mapped, compressed ones (chess_datagen's) are decompressed into memory a chunk
+//            at a time, which needs chess_tune built with zlib.
+//            -e <epochs>   default 500
+//            -l <rate>     Adam step size in centipawns, default 1
+//            -k <K>        sigmoid scale, default fits it to the data first
+//            -t <threads>  default one per core
+//            -o <file>     where to write the tuned tables, default EvaluationTables.h. Rewritten every 50 epochs.
+
+// Parameters are the material value of each piece but the king, then a 64 square table for each of them.
+// Kings are always on the board once per side, so their value cancels out; the king table isn't used by evaluation yet.
+const int TUNED_PIECES = 5;
+const int PARAMS = TUNED_PIECES + TUNED_PIECES * 64;
+
+static const char* const pieceNames[TUNED_PIECES] = {"pawn", "knight", "bishop", "rook", "queen"};
+
+static std::vector<double> initialParams() {
+	const int values[TUNED_PIECES] = {pawnValue, knightValue, bishopValue, rookValue, queenValue};
+	const int* tables[TUNED_PIECES] = {pawnTable, knightTable, bishopTable, rookTable, queenTable};
+
+	std::vector<double> params(PARAMS);
+	for (int piece = 0; piece < TUNED_PIECES; piece++) {
+		params[piece] = values[piece];
+		for (int square = 0; square < 64; square++) {
+			params[TUNED_PIECES + piece * 64 + square] = tables[piece][square];
+		}
+	}
+	return params;
+}
+
+// KPK is looked up in the bitbase instead of evaluated, so those positions say nothing about the tables.
+static bool isEvaluated(const PackedPosition& position) {
+	if (popCount(position.occupancy) != 3) return true;
+	for (int n = 0; n < 3; n++) {
+		if (((position.pieces[n >> 1] >> ((n & 1) * 4)) & 7) == Pawn) return false;
+	}
+	return true;
+}
+
+// Calls f(parameter, sign) for every term of the evaluation, which is just the sum of sign * params[parameter].
+// Mirrors the material & table part of ChessAI::evaluateBoard: white positive, and black's squares flipped onto white's
+// side of the tables. Pawn structure, mobility & king safety aren't tuned, they come in as a fixed offset (see fixedOffset).
+template<typename F>
+static inline void forEachTerm(const PackedPosition& position, F&& f) {
+	int n = 0;
+	forEachBit([&](uint8_t square) {
+		const int piece = (position.pieces[n >> 1] >> ((n & 1) * 4)) & 15;
+		n++;
+
+		const int type = (piece & 7) - 1;
+		if (type >= TUNED_PIECES) return;
+		const bool black = (piece & Black) != 0;
+		const int sign = black ? -1 : 1;
+		f(type, sign);
+		f(TUNED_PIECES + type * 64 + (black ? square ^ 56 : square), sign);
+	}, position.occupancy);
+}
+
+// The untuned rest of the evaluation. It doesn't depend on params, so it's worked out once per position.
+static int16_t fixedOffset(const PackedPosition& position) {
+	const GameState state = position.unpack();
+	const ProtoBoard& board = state.getProtoBoard();
+	uint64_t passed;
+	return (int16_t)(PawnStructure::evaluate(board, passed) + PawnStructure::evaluatePassers(board, passed)
+		+ PieceActivity::evaluate(board));
+}
+
+static inline double evaluate(const PackedPosition& position, const int offset, const std::vector<double>& params) {
+	double eval = offset;
+	forEachTerm(position, [&eval, &params](const int parameter, const int sign) {
+		eval += sign * params[parameter];
+	});
+	return eval;
+}
+
+static inline double sigmoid(const double K, const double eval) {
+	// 10^x as e^(x ln 10), exp is a good deal cheaper than pow.
+	return 1.0 / (1.0 + std::exp(-K * eval * (2.302585092994046 / 400.0)));
+}
+
+static inline double target(const TrainingPosition& position) {
+	return (position.result + 1) * 0.5;
+}
+
+// Threads that stay up for the whole run. The tuner goes over the data a couple of times per epoch (and a few dozen times
+// fitting K), and starting a fresh set of threads for every one of those adds up.
+class WorkerPool {
+	public:
+	using Job = std::function<void(size_t begin, size_t end, unsigned thread)>;
+
+	explicit WorkerPool(const unsigned threads) : _threads(threads) {
+		// the calling thread takes slice 0 itself.
+		for (unsigned t = 1; t < _threads; t++) {
+			_workers.emplace_back([this, t] { work(t); });
+		}
+	}
+
+	~WorkerPool() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_quit = true;
+		}
+		_wake.notify_all();
+		for (std::thread& worker : _workers) {
+			worker.join();
+		}
+	}
+
+	// Splits [0, count) into one contiguous slice per thread, runs job(begin, end, thread) on each and waits for them all.
+	// If any slice throws, the first exception is rethrown here once they're all done.
+	void parallelFor(const size_t count, const Job& job) {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_job = &job;
+			_count = count;
+			_pending = _threads - 1;
+			_generation++;
+		}
+		_wake.notify_all();
+		runSlice(0);
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		_done.wait(lock, [this] { return _pending == 0; });
+		_job = nullptr;
+		if (_error) {
+			std::exception_ptr error = nullptr;
+			std::swap(error, _error);
+			std::rethrow_exception(error);
+		}
+	}
+
+	private:
+	void runSlice(const unsigned t) {
+		const size_t slice = (_count + _threads - 1) / _threads;
+		const size_t begin = std::min(_count, t * slice);
+		const size_t end = std::min(_count, begin + slice);
+		try {
+			(*_job)(begin, end, t);
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_error) _error = std::current_exception();
+		}
+	}
+
+	void work(const unsigned t) {
+		uint64_t seen = 0;
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_wake.wait(lock, [this, seen] { return _quit || _generation != seen; });
+				if (_quit) return;
+				seen = _generation;
+			}
+			runSlice(t);
+
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (--_pending == 0) _done.notify_one();
+		}
+	}
+
+	const unsigned _threads;
+	std::vector<std::thread> _workers;
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	std::condition_variable _done;
+	const Job* _job = nullptr;
+	std::exception_ptr _error;
+	size_t _count = 0;
+	unsigned _pending = 0;
+	uint64_t _generation = 0;
+	bool _quit = false;
+};
+
+class Tuner {
+	public:
+	Tuner(const TrainingPosition* data, const size_t count, const unsigned threads)
+		: _data(data), _count(count), _threads(threads), _pool(threads), _gradients(threads, std::vector<double>(PARAMS)),
+		  _errors(threads), _offsets(count) {
+		std::vector<size_t> used(_threads);
+		_pool.parallelFor(_count, [this, &used](const size_t begin, const size_t end, const unsigned t) {
+			for (size_t i = begin; i < end; i++) {
+				try {
+					_offsets[i] = fixedOffset(_data[i].position);
+				} catch (const std::exception& e) {
+					throw std::runtime_error("Position " + std::to_string(i) + ": " + e.what());
+				}
+				used[t] += isEvaluated(_data[i].position);
+			}
+		});
+		for (const size_t n : used) _used += n;
+		if (_used == 0) throw std::runtime_error("No positions the evaluation can be tuned on");
+	}
+
+	// positions that actually go into the error, the rest are KPK.
+	size_t used() const { return _used; }
+
+	double error(const std::vector<double>& params, const double K) {
+		_pool.parallelFor(_count, [&](const size_t begin, const size_t end, const unsigned t) {
+			double sum = 0;
+			for (size_t i = begin; i < end; i++) {
+				if (!isEvaluated(_data[i].position)) continue;
+				const double diff = target(_data[i]) - sigmoid(K, evaluate(_data[i].position, _offsets[i], params));
+				sum += diff * diff;
+			}
+			_errors[t] = sum;
+		});
+
+		double total = 0;
+		for (const double e : _errors) total += e;
+		return total / _used;
+	}
+
+	// d(error)/d(param) for every parameter, plus the error itself since it falls out of the same pass.
+	double gradient(const std::vector<double>& params, const double K, std::vector<double>& gradient) {
+		_pool.parallelFor(_count, [&](const size_t begin, const size_t end, const unsigned t) {
+			std::vector<double>& local = _gradients[t];
+			std::fill(local.begin(), local.end(), 0.0);
+			double sum = 0;
+			for (size_t i = begin; i < end; i++) {
+				const PackedPosition& position = _data[i].position;
+				if (!isEvaluated(position)) continue;
+
+				const double s = sigmoid(K, evaluate(position, _offsets[i], params));
+				const double diff = target(_data[i]) - s;
+				sum += diff * diff;
+				// chain rule, minus the constant factors which get applied once at the end.
+				const double term = diff * s * (1 - s);
+				forEachTerm(position, [&local, term](const int parameter, const int sign) {
+					local[parameter] += sign * term;
+				});
+			}
+			_errors[t] = sum;
+		});
+
+		const double scale = -2.0 * K * std::log(10.0) / 400.0 / _used;
+		std::fill(gradient.begin(), gradient.end(), 0.0);
+		double total = 0;
+		for (unsigned t = 0; t < _threads; t++) {
+			for (int p = 0; p < PARAMS; p++) {
+				gradient[p] += _gradients[t][p] * scale;
+			}
+			total += _errors[t];
+		}
+		return total / _used;
+	}
+
+	// the K the current eval fits best, by golden section search. The error is unimodal in K.
+	double fitK(const std::vector<double>& params) {
+		const double ratio = (std::sqrt(5.0) - 1) / 2;
+		double lo = 0.0, hi = 4.0;
+		double a = hi - ratio * (hi - lo), b = lo + ratio * (hi - lo);
+		double errorA = error(params, a), errorB = error(params, b);
+		while (hi - lo > 1e-4) {
+			if (errorA < errorB) {
+				hi = b;
+				b = a;
+				errorB = errorA;
+				a = hi - ratio * (hi - lo);
+				errorA = error(params, a);
+			} else {
+				lo = a;
+				a = b;
+				errorA = errorB;
+				b = lo + ratio * (hi - lo);
+				errorB = error(params, b);
+			}
+		}
+		return (lo + hi) / 2;
+	}
+
+	private:
+	const TrainingPosition* _data;
+	const size_t _count;
+	const unsigned _threads;
+	size_t _used = 0;
+	WorkerPool _pool;
+	std::vector<std::vector<double>> _gradients; // one per thread, summed afterwards
+	std::vector<double> _errors;
+	std::vector<int16_t> _offsets; // fixedOffset of each position
+};
+
+static void writeTable(std::ostream& out, const char* name, const int* values) {
+	out << "const int " << name << "[64] = {\n";
+	for (int row = 0; row < 8; row++) {
+		out << "    ";
+		for (int col = 0; col < 8; col++) {
+			out << values[row * 8 + col];
+			if (row * 8 + col != 63) out << (col == 7 ? "," : ", ");
+		}
+		out << '\n';
+	}
+	out << "};\n";
+}
+
+// Writes the parameters back out in EvaluationTables.h's format, so the result can be dropped straight in.
+static void exportTables(const std::string& path, const std::vector<double>& params, const double error) {
+	std::ofstream out(path, std::ios::trunc);
+	if (!out) throw std::runtime_error("Couldn't write " + path);
+
+	int rounded[PARAMS];
+	for (int p = 0; p < PARAMS; p++) {
+		rounded[p] = (int)std::lround(params[p]);
+	}
+
+	out << "#pragma once\n\n";
+	out << "// Generated by chess_tune (mean squared error " << error << ").\n";
+	out << "// Piece values. Kings are priceless, this just has to outweigh everything else put together.\n";
+	for (int piece = 0; piece < TUNED_PIECES; piece++) {
+		std::string name = std::string(pieceNames[piece]) + "Value";
+		name.resize(11, ' ');
+		out << "const int " << name << " = " << rounded[piece] << ";\n";
+	}
+	out << "const int kingValue   = " << kingValue << ";\n\n";
+
+	out << "// Piece square tables, indexed by square from white's side (a1 = 0). Black's squares are flipped onto them.\n";
+	for (int piece = 0; piece < TUNED_PIECES; piece++) {
+		writeTable(out, (std::string(pieceNames[piece]) + "Table").c_str(), rounded + TUNED_PIECES + piece * 64);
+		out << '\n';
+	}
+	out << "// Not tuned, evaluation doesn't use it yet.\n";
+	writeTable(out, "kingTable", kingTable);
+}
+
+struct TuneOptions {
+	const char* data = nullptr;
+	const char* output = "EvaluationTables.h";
+	int epochs = 500;
+	double rate = 1.0;
+	double K = 0;
+	unsigned threads = 0;
+};
+
+static int tune(const TuneOptions& options) {
+	MappedFile file;
+	if (!file.open(options.data)) {
+		std::fprintf(stderr, "Couldn't open %s\n", options.data);
+		return 1;
+	}
+	const TrainingPosition* data = reinterpret_cast<const TrainingPosition*>(file.data());
+	size_t count = file.size() / sizeof(TrainingPosition);
+
+	std::vector<TrainingPosition> decompressed;
+	if (file.size() >= sizeof(TRAINING_MAGIC) && std::memcmp(file.data(), TRAINING_MAGIC, sizeof(TRAINING_MAGIC)) == 0) {
+#ifdef CHESS_TRAINING_ZLIB
+		file.close();
+		std::ifstream in(options.data, std::ios::binary);
+		TrainingReader reader(in);
+		std::vector<TrainingPosition> chunk;
+		while (reader.next(chunk)) {
+			decompressed.insert(decompressed.end(), chunk.begin(), chunk.end());
+		}
+		data = decompressed.data();
+		count = decompressed.size();
+#else
+		std::fprintf(stderr, "%s is compressed and chess_tune was built without zlib, run chess_datagen unpack on it first\n",
+			options.data);
+		return 1;
+#endif
+	}
+	Tuner tuner(data, count, options.threads);
+	std::printf("%zu positions (%zu tuned on, the rest are KPK), %u threads\n", count, tuner.used(), options.threads);
+	std::vector<double> params = initialParams();
+
+	const double K = options.K > 0 ? options.K : tuner.fitK(params);
+	std::printf("K = %.4f, starting error %.6f\n", K, tuner.error(params, K));
+
+	// Adam, the parameters' gradients differ by orders of magnitude (material vs a rarely visited square),
+	// so plain gradient descent either crawls or blows up.
+	const double beta1 = 0.9, beta2 = 0.999, epsilon = 1e-8;
+	std::vector<double> gradient(PARAMS), m(PARAMS), v(PARAMS);
+	double error = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (int epoch = 1; epoch <= options.epochs; epoch++) {
+		error = tuner.gradient(params, K, gradient);
+		for (int p = 0; p < PARAMS; p++) {
+			m[p] = beta1 * m[p] + (1 - beta1) * gradient[p];
+			v[p] = beta2 * v[p] + (1 - beta2) * gradient[p] * gradient[p];
+			const double mHat = m[p] / (1 - std::pow(beta1, epoch));
+			const double vHat = v[p] / (1 - std::pow(beta2, epoch));
+			params[p] -= options.rate * mHat / (std::sqrt(vHat) + epsilon);
+		}
+
+		if (epoch % 10 == 0 || epoch == options.epochs) {
+			const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			std::printf("epoch %d  error %.6f  %.0f positions/s\n", epoch, error, count * (double)epoch / seconds);
+		}
+		if (epoch % 50 == 0) {
+			exportTables(options.output, params, error);
+		}
+	}
+
+	exportTables(options.output, params, tuner.error(params, K));
+	std::printf("wrote %s\n", options.output);
+	return 0;
+}
+
+// Game result tag/EPD annotation to a label, false if there isn't one.
+static bool parseResult(const std::string& text, int8_t& result) {
+	if (text.find("1/2-1/2") != std::string::npos || text.find("[0.5]") != std::string::npos) {
+		result = 0;
+	} else if (text.find("1-0") != std::string::npos || text.find("[1.0]") != std::string::npos) {
+		result = 1;
+	} else if (text.find("0-1") != std::string::npos || text.find("[0.0]") != std::string::npos) {
+		result = -1;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static void writePosition(std::ostream& out, const GameState& state, const int8_t result) {
+	TrainingPosition position = {};
+	position.position = PackedPosition::pack(state);
+	position.result = result;
+	out.write(reinterpret_cast<const char*>(&position), sizeof(position));
+}
+
+// Every position from the game with a result, skipping the opening and anything that isn't quiet (side to move in
+// check, or about to capture), since the eval can't see tactics and they'd only add noise.
+static uint64_t packGames(std::istream& in, std::ostream& out, const int skipPlies) {
+	PGN::Reader reader(in);
+	PGN::Game game;
+	uint64_t written = 0;
+	while (reader.next(game)) {
+		int8_t result;
+		if (!parseResult(game.result, result)) continue;
+
+		GameState state = game.start;
+		for (size_t ply = 0; ply < game.moves.size(); ply++) {
+			const Move& move = game.moves[ply];
+			const bool capture = move.isEnCapture() ||
+				(state.getEnemyOccuupancyBoard() & (1ULL << move.getTo())) != 0;
+			const bool inCheck = Chess::isSquareAttacked(state, state.getFriendlyKingSquare(), state.getOccupancyBoard());
+			if ((int)ply >= skipPlies && !capture && !inCheck) {
+				writePosition(out, state, result);
+				written++;
+			}
+			state.MakeMove(move);
+		}
+	}
+	return written;
+}
+
+static uint64_t packEPD(std::istream& in, std::ostream& out) {
+	std::string line;
+	uint64_t written = 0;
+	while (std::getline(in, line)) {
+		int8_t result;
+		if (!parseResult(line, result)) continue;
+		try {
+			writePosition(out, GameState::FromFEN(line), result);
+			written++;
+		} catch (const std::exception&) {
+			// not a position, skip it.
+		}
+	}
+	return written;
+}
+
+static int pack(int argc, char** argv) {
+	const char* outPath = nullptr;
+	int skipPlies = 8;
+	std::vector<const char*> inputs;
+	for (int i = 2; i < argc; i++) {
+		const bool hasValue = i + 1 < argc;
+		if (!std::strcmp(argv[i], "-o") && hasValue) {
+			outPath = argv[++i];
+		} else if (!std::strcmp(argv[i], "-s") && hasValue) {
+			skipPlies = std::atoi(argv[++i]);
+		} else {
+			inputs.push_back(argv[i]);
+		}
+	}
+	if (!outPath || inputs.empty()) throw std::runtime_error("pack needs -o and at least one input");
+
+	std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+	if (!out) throw std::runtime_error(std::string("Couldn't create ") + outPath);
+
+	uint64_t written = 0;
+	for (const char* path : inputs) {
+		std::ifstream in(path, std::ios::binary);
+		if (!in) throw std::runtime_error(std::string("Couldn't open ") + path);
+
+		const std::string name = path;
+		const bool isPGN = name.size() > 4 && name.compare(name.size() - 4, 4, ".pgn") == 0;
+		written += isPGN ? packGames(in, out, skipPlies) : packEPD(in, out);
+	}
+	std::printf("%llu positions written to %s\n", (unsigned long long)written, outPath);
+	return 0;
+}
+
+static TuneOptions parseTuneOptions(int argc, char** argv) {
+	TuneOptions options;
+	for (int i = 2; i < argc; i++) {
+		const bool hasValue = i + 1 < argc;
+		if (!std::strcmp(argv[i], "-e") && hasValue) {
+			options.epochs = std::atoi(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-l") && hasValue) {
+			options.rate = std::atof(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-k") && hasValue) {
+			options.K = std::atof(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-t") && hasValue) {
+			options.threads = (unsigned)std::atoi(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-o") && hasValue) {
+			options.output = argv[++i];
+		} else if (argv[i][0] == '-') {
+			throw std::runtime_error(std::string("Unknown option ") + argv[i]);
+		} else {
+			options.data = argv[i];
+		}
+	}
+
+	if (!options.data) throw std::runtime_error("tune needs a dataset");
+	if (options.threads == 0) {
+		options.threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	return options;
+}
+
+int main(int argc, char** argv) {
+	try {
+		if (argc > 1 && !std::strcmp(argv[1], "pack")) return pack(argc, argv);
+		if (argc > 1 && !std::strcmp(argv[1], "tune")) return tune(parseTuneOptions(argc, argv));
+	} catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+
+	std::fprintf(stderr, "usage: chess_tune pack [-s plies] -o data.bin file.pgn|file.epd...\n"
+		"       chess_tune tune [-e epochs] [-l rate] [-k K] [-t threads] [-o EvaluationTables.h] data.bin|data.tdz\n");
+	return 1;
+}